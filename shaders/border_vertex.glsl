@@ -3,8 +3,18 @@
 layout(location = 0) in vec3 position;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
 
 void main() {
     gl_Position = projection * view * model * vec4(position, 1.0);
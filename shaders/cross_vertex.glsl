@@ -1,18 +1,55 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-
 out vec2 TexCoord;
 out vec3 WorldPos;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform isamplerBuffer chunkPages; // MeshArena page table, chunk x/z of every 256 vertices
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
+uniform usamplerBuffer crossTemplates; // CrossMesh::getTemplateTexture()
+uniform usamplerBuffer crossInstances; // packCrossInstance() values in the cross MeshArena
+uniform int verticesPerInstance; // CrossMesh::getVerticesPerInstance()
+
+const int quadCorners[6] = int[6](0, 1, 2, 2, 3, 0);
 
 void main() {
-    vec4 worldPosition = model * vec4(aPos, 1.0);
+    int instance = gl_VertexID / verticesPerInstance;
+    int instanceVertex = gl_VertexID - instance * verticesPerInstance;
+    uint aInstance = texelFetch(crossInstances, instance).x;
+
+    // Texel at the block ID points at its plane templates: first texel, quad count
+    uvec2 templateRange = texelFetch(crossTemplates, int(aInstance >> 16)).xy;
+    int quad = instanceVertex / 6;
+    if (quad >= int(templateRange.y)) {
+        // Blocks with fewer quads than the largest template drop the rest outside the clip volume
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        TexCoord = vec2(0.0);
+        WorldPos = vec3(0.0);
+        return;
+    }
+    uvec2 aPacked = texelFetch(crossTemplates, int(templateRange.x) + quad * 4 + quadCorners[instanceVertex % 6]).xy;
+
+    // Template vertex in ChunkVertex layout, see chunkVertex.hpp
+    vec3 position = vec3(float(aPacked.x & 1023u), float(aPacked.y & 16383u), float((aPacked.x >> 10) & 1023u)) / 32.0 - 1.0;
+    position += vec3(float(aInstance & 15u), float((aInstance >> 8) & 255u), float((aInstance >> 4) & 15u));
+    uint tile = (aPacked.y >> 14) & 255u;
+    vec2 tileOrigin = vec2(float(tile & 15u), float(tile >> 4));
+    vec2 uv = vec2(float((aPacked.y >> 22) & 31u), float(aPacked.y >> 27));
+
+    // Chunk origin relative to the camera, see vertex.glsl
+    ivec2 chunk = texelFetch(chunkPages, instance >> 8).xy - cameraChunk;
+    vec3 chunkOrigin = vec3(float(chunk.x * 16), 0.0, float(chunk.y * 16)) - cameraOffset;
+    vec4 worldPosition = vec4(chunkOrigin + position, 1.0);
     gl_Position = projection * view * worldPosition;
-    TexCoord = aTexCoord;
+    TexCoord = (tileOrigin + uv / 16.0) / 16.0;
     WorldPos = worldPosition.xyz;
 }
\ No newline at end of file
@@ -2,17 +2,30 @@
 
 in vec2 TexCoord;
 in float FaceID;
+flat in vec2 Tile;
 in vec3 WorldPos;
+in float Occlusion;
 out vec4 FragColor;
 
 uniform sampler2D atlas;
-uniform vec3 fogColor;
-uniform vec3 cameraPos;
-uniform float fogStartDistance;
-uniform float fogDensity;
+
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
 
 void main() {
-    vec4 texColor = texture(atlas, TexCoord);
+    vec2 uv = TexCoord;
+    if (Tile.x > 0.0) // Greedy quads count in tiles, repeat the one tile across the merged face
+        uv = (Tile - 1.0 + fract(TexCoord)) / 16.0;
+    vec4 texColor = texture(atlas, uv);
 
     if (texColor.a == 0.0)
         discard;
@@ -30,7 +43,7 @@ void main() {
         case 5: brightness = 0.60; break; // Bottom
     }
 
-    vec4 baseColor = vec4(texColor.rgb * brightness, texColor.a);
+    vec4 baseColor = vec4(texColor.rgb * brightness * Occlusion, texColor.a);
 
     float distance = length(WorldPos - cameraPos);
     float adjustedDistance = max(0.0, distance - fogStartDistance);
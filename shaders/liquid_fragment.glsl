@@ -6,10 +6,18 @@ in vec3 WorldPos;
 out vec4 FragColor;
 
 uniform sampler2D atlas;
-uniform vec3 fogColor;
-uniform vec3 cameraPos;
-uniform float fogStartDistance;
-uniform float fogDensity;
+
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
 
 void main() {
     vec4 texColor = texture(atlas, TexCoord);
@@ -0,0 +1,55 @@
+#version 330 core
+
+in vec2 TexCoord;
+in float FaceID;
+in vec3 WorldPos;
+layout (location = 0) out vec4 Accumulation; // See liquidOIT.hpp
+layout (location = 1) out float Weight;
+
+uniform sampler2D atlas;
+
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
+
+void main() {
+    vec4 texColor = texture(atlas, TexCoord);
+
+    if (texColor.a == 0.0)
+        discard;
+
+    float brightness = 1.0;
+
+    int faceIndex = int(FaceID + 0.5);
+    
+    switch(faceIndex) {
+        case 0: brightness = 0.90; break; // Front
+        case 1: brightness = 0.90; break; // Back
+        case 2: brightness = 0.75; break; // Left
+        case 3: brightness = 0.75; break; // Right
+        case 4: brightness = 1.03; break; // Top
+        case 5: brightness = 0.60; break; // Bottom
+    }
+
+    vec4 baseColor = vec4(texColor.rgb * brightness, texColor.a);
+
+    float distance = length(WorldPos - cameraPos);
+    float adjustedDistance = max(0.0, distance - fogStartDistance);
+    float fogFactor = exp(-fogDensity * adjustedDistance);
+
+    vec3 finalColor = mix(fogColor, baseColor.rgb, fogFactor);
+
+    // Distance falloff from McGuire & Bavoil's weighted blended OIT, nearer surfaces dominate the average
+    float alpha = baseColor.a;
+    float weight = clamp(10.0 / (1e-5 + pow(distance / 5.0, 2.0) + pow(distance / 200.0, 6.0)), 1e-2, 3e3);
+    Accumulation = vec4(finalColor * alpha * weight, alpha);
+    Weight = alpha * weight;
+}
\ No newline at end of file
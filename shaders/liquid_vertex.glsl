@@ -1,32 +1,47 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in float aFaceID;
-layout (location = 3) in float aIsTop;
+layout (location = 0) in uvec2 aPacked; // ChunkVertex, see chunkVertex.hpp
 
 out vec2 TexCoord;
 out float FaceID;
 out vec3 WorldPos;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform float time;
+uniform isamplerBuffer chunkPages; // MeshArena page table, chunk x/z of every 256 vertices
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
 
 float pi = 3.1415926535;
 
 void main() {
-    vec3 animatedPos = aPos;
-    if (aIsTop > 0.5) {
+    // x/z at 1/32 block in low bits 0-19, y in high bits 0-13, all offset by one block
+    vec3 position = vec3(float(aPacked.x & 1023u), float(aPacked.y & 16383u), float((aPacked.x >> 10) & 1023u)) / 32.0 - 1.0;
+    uint tile = (aPacked.y >> 14) & 255u;
+    vec2 tileOrigin = vec2(float(tile & 15u), float(tile >> 4));
+    vec2 uv = vec2(float((aPacked.y >> 22) & 31u), float(aPacked.y >> 27));
+    bool isTop = ((aPacked.x >> 23) & 1u) != 0u;
+
+    vec3 animatedPos = position;
+    if (isTop) {
         animatedPos.y -= 0.18;
         // Formula taken from WSAL Evan --> https://github.com/EvanatorM/ScuffedMinecraft
-        animatedPos.y += (sin(aPos.x * pi / 2.0 + time) + sin(aPos.z * pi / 2.0 + time * 1.5)) * 0.04;
+        animatedPos.y += (sin(position.x * pi / 2.0 + time) + sin(position.z * pi / 2.0 + time * 1.5)) * 0.04;
     }
 
-    vec4 worldPosition = model * vec4(animatedPos, 1.0);
+    // Chunk origin relative to the camera, see vertex.glsl
+    ivec2 chunk = texelFetch(chunkPages, gl_VertexID >> 8).xy - cameraChunk;
+    vec3 chunkOrigin = vec3(float(chunk.x * 16), 0.0, float(chunk.y * 16)) - cameraOffset;
+    vec4 worldPosition = vec4(chunkOrigin + animatedPos, 1.0);
     gl_Position = projection * view * worldPosition;
-    TexCoord = aTexCoord;
-    FaceID = aFaceID;
+    TexCoord = (tileOrigin + uv / 16.0) / 16.0;
+    FaceID = float((aPacked.x >> 20) & 7u);
     WorldPos = worldPosition.xyz;
 }
\ No newline at end of file
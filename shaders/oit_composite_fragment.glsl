@@ -0,0 +1,17 @@
+#version 330 core
+
+in vec2 TexCoord;
+out vec4 FragColor;
+
+uniform sampler2D accumulation; // rgb: sum of color * alpha * weight, a: revealage, see liquidOIT.hpp
+uniform sampler2D weight;       // r: sum of alpha * weight
+
+void main() {
+    vec4 accum = texture(accumulation, TexCoord);
+    float revealage = accum.a;
+    if (revealage >= 1.0)
+        discard; // No liquid here
+
+    vec3 averageColor = accum.rgb / max(texture(weight, TexCoord).r, 1e-5);
+    FragColor = vec4(averageColor, 1.0 - revealage);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 330 core
+
+out vec2 TexCoord;
+
+void main() {
+    // Fullscreen triangle from the vertex ID, no vertex buffer
+    vec2 position = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));
+    TexCoord = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
\ No newline at end of file
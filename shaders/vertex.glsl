@@ -1,21 +1,49 @@
 #version 330 core
 
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-layout (location = 2) in float aFaceID;
+layout (location = 0) in uvec2 aPacked; // ChunkVertex, see chunkVertex.hpp
 
 out vec2 TexCoord;
 out float FaceID;
+flat out vec2 Tile; // Atlas tile + 1 for greedy quads, 0 when TexCoord is already an atlas UV
 out vec3 WorldPos;
+out float Occlusion; // Baked ambient occlusion brightness, 1.0 when open
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform isamplerBuffer chunkPages; // MeshArena page table, chunk x/z of every 256 vertices
+layout (std140) uniform FrameData { // FrameData in frameData.hpp, written once per frame
+    mat4 view;
+    mat4 projection;
+    vec3 fogColor;
+    float fogDensity;
+    vec3 cameraPos;
+    float fogStartDistance;
+    vec3 cameraOffset; // Camera position inside its chunk
+    float time;
+    ivec2 cameraChunk;
+};
+
+const float occlusionCurve[4] = float[4](1.0, 0.8, 0.65, 0.5);
 
 void main() {
-    vec4 worldPosition = model * vec4(aPos, 1.0);
+    // x/z at 1/32 block in low bits 0-19, y in high bits 0-13, all offset by one block
+    vec3 position = vec3(float(aPacked.x & 1023u), float(aPacked.y & 16383u), float((aPacked.x >> 10) & 1023u)) / 32.0 - 1.0;
+    uint tile = (aPacked.y >> 14) & 255u;
+    vec2 tileOrigin = vec2(float(tile & 15u), float(tile >> 4));
+    vec2 uv = vec2(float((aPacked.y >> 22) & 31u), float(aPacked.y >> 27));
+    bool tiled = ((aPacked.x >> 24) & 1u) != 0u;
+
+    // Relative to the camera's chunk in integers, so the positions stay small far from the origin
+    ivec2 chunk = texelFetch(chunkPages, gl_VertexID >> 8).xy - cameraChunk;
+    vec3 chunkOrigin = vec3(float(chunk.x * 16), 0.0, float(chunk.y * 16)) - cameraOffset;
+    vec4 worldPosition = vec4(chunkOrigin + position, 1.0);
     gl_Position = projection * view * worldPosition;
-    TexCoord = aTexCoord;
-    FaceID = aFaceID;
+    if (tiled) {
+        TexCoord = uv; // Whole tiles, repeated in the fragment shader
+        Tile = tileOrigin + 1.0;
+    } else {
+        TexCoord = (tileOrigin + uv / 16.0) / 16.0;
+        Tile = vec2(0.0);
+    }
+    FaceID = float((aPacked.x >> 20) & 7u);
+    Occlusion = occlusionCurve[(aPacked.x >> 25) & 3u];
     WorldPos = worldPosition.xyz;
 }
\ No newline at end of file
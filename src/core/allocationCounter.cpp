@@ -0,0 +1,47 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "allocationCounter.hpp"
+
+static std::atomic<bool> countingEnabled{false};
+static std::atomic<size_t> allocationCount{0};
+static thread_local int scopeDepth = 0;
+
+void AllocationCounter::setEnabled(bool enabled) {
+    countingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AllocationCounter::isEnabled() {
+    return countingEnabled.load(std::memory_order_relaxed);
+}
+
+size_t AllocationCounter::getCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+AllocationCounter::Scope::Scope() {
+    scopeDepth++;
+}
+
+AllocationCounter::Scope::~Scope() {
+    scopeDepth--;
+}
+
+// Array and nothrow new forward to this one. Over-aligned new keeps the library version
+void* operator new(std::size_t size) {
+    if (scopeDepth > 0 && countingEnabled.load(std::memory_order_relaxed))
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (!pointer)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
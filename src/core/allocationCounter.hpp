@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+// Counts every operator new made on a thread while it is inside a Scope, through a replaced global
+// operator new. Off unless the `count_allocations` option is set, the hook then only reads one flag.
+// Shows whether warmed up mesh rebuilds and uploads still touch the heap
+class AllocationCounter {
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    static size_t getCount();
+
+    // Counts allocations on this thread until destroyed, scopes may nest
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
@@ -4,7 +4,6 @@
 #include "../world/world.hpp"
 #include "../world/chunk.hpp"
 #include "../world/blockDB.hpp"
-#include "../world/modelDB.hpp"
 
 Camera::Camera(glm::vec3 position, glm::vec3 up, float yaw, float pitch)
     : position(glm::dvec3(position)), worldUp(up), yaw(yaw), pitch(pitch), movementSpeed(2.5f), mouseSensitivity(0.1f) {
@@ -64,18 +63,6 @@ void Camera::updateCameraVectors() {
     up = glm::normalize(glm::cross(right, front));
 }
 
-static void getBlockAABBs(uint8_t blockId, std::vector<std::pair<glm::vec3, glm::vec3>>& outBoxes) {
-    const BlockDB::BlockInfo* info = BlockDB::getBlockInfo(blockId);
-    if (!info) {
-        outBoxes.push_back({glm::vec3(0.0f), glm::vec3(1.0f)});
-        return;
-    }
-
-    if (!ModelDB::getCollisionBoxes(info->modelName, outBoxes)) {
-        outBoxes.push_back({glm::vec3(0.0f), glm::vec3(1.0f)});
-    }
-}
-
 static const double COLLISION_EPS = 1e-6;
 static bool aabbOverlap(const glm::dvec3& amin, const glm::dvec3& amax, const glm::dvec3& bmin, const glm::dvec3& bmax) {
     return (amin.x <= bmax.x - COLLISION_EPS && amax.x >= bmin.x + COLLISION_EPS) &&
@@ -123,12 +110,10 @@ void Camera::stepVelocity(float deltaTime, World* world) {
     glm::dvec3 horizMove = glm::dvec3(velocity.x, 0.0, velocity.z) * static_cast<double>(deltaTime);
     double feetY_current = position.y - eyeHeight;
 
-    auto isBlockSolid = [&](uint8_t type) -> bool {
+    auto isBlockSolid = [&](uint16_t type) -> bool {
         if (type == 0) return false;
-        const BlockDB::BlockInfo* info = BlockDB::getBlockInfo(type);
-        if (!info) return true;
-        std::vector<std::pair<glm::vec3, glm::vec3>> boxes;
-        return ModelDB::getCollisionBoxes(info->modelName, boxes);
+        uint16_t flags = BlockDB::getFlags(type);
+        return !(flags & BlockDB::Known) || (flags & BlockDB::HasCollision); // Unknown IDs stay solid
     };
 
     auto collidesWithTop = [&](const glm::dvec3& aabbMin, const glm::dvec3& aabbMax, World* world, double& outBlockTop) -> bool {
@@ -149,13 +134,10 @@ void Camera::stepVelocity(float deltaTime, World* world) {
                         localY < 0 || localY >= Chunk::chunkHeight ||
                         localZ < 0 || localZ >= Chunk::chunkDepth) continue;
 
-                    uint8_t type = chunk->blocks[localX][localY][localZ].type;
+                    uint16_t type = chunk->getBlock(localX, localY, localZ);
                     if (!isBlockSolid(type)) continue;
 
-                    std::vector<std::pair<glm::vec3, glm::vec3>> boxes;
-                    getBlockAABBs(type, boxes);
-
-                    for (const auto& [minF, maxF] : boxes) {
+                    for (const auto& [minF, maxF] : BlockDB::getCollisionBoxes(type)) {
                         glm::dvec3 bmin = glm::dvec3(minF) + glm::dvec3(blockX, blockY, blockZ);
                         glm::dvec3 bmax = glm::dvec3(maxF) + glm::dvec3(blockX, blockY, blockZ);
 
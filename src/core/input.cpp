@@ -16,27 +16,27 @@ static Camera* g_camera = nullptr;
 static World* g_world = nullptr;
 static float lastX;
 static float lastY;
-static uint8_t selectedBlockType = 1; // Default to grass
+static uint16_t selectedBlockType = 1; // Default to grass
 bool flyMode = false;
 bool wireframeEnabled = false;
 bool ingoreInput = false;
 bool zoomedIn = false;
 int selectedHotbarIndex = 0;
-std::array<uint8_t, 9> hotbarBlocks = {1, 2, 3, 4, 5, 6, 7, 8, 14};
+std::array<uint16_t, 9> hotbarBlocks = {1, 2, 3, 4, 5, 6, 7, 8, 14};
 
 bool getZoomState(GLFWwindow*) {
     return zoomedIn;
 }
 
-uint8_t getSelectedBlockType() {
+uint16_t getSelectedBlockType() {
     return selectedBlockType;
 }
 
-void setSelectedBlockType(uint8_t type) {
+void setSelectedBlockType(uint16_t type) {
     selectedBlockType = type;
 }
 
-void setHotbarBlock(int index, uint8_t type) {
+void setHotbarBlock(int index, uint16_t type) {
     hotbarBlocks[index] = type;
 }
 
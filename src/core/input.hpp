@@ -2,9 +2,9 @@
 #include <GLFW/glfw3.h>
 #include "camera.hpp"
 
-uint8_t getSelectedBlockType();
-void setSelectedBlockType(uint8_t type);
-void setHotbarBlock(int index, uint8_t type);
+uint16_t getSelectedBlockType();
+void setSelectedBlockType(uint16_t type);
+void setHotbarBlock(int index, uint16_t type);
 void setupInputCallbacks(GLFWwindow* window, Camera* camera, class World* world);
 void processInput(GLFWwindow* window, Camera& camera, float deltaTime, float speedMultiplier);
 float getSpeedMultiplier(GLFWwindow* window);
@@ -0,0 +1,65 @@
+#include "workerPool.hpp"
+
+WorkerPool::WorkerPool(int threadCount) {
+    if (threadCount < 1)
+        threadCount = 1;
+    threads.reserve(threadCount);
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        // Jobs that never started are dropped, their owners clean up after the pool is gone
+        jobs = {};
+    }
+    jobAvailable.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(int priority, std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push({priority, nextSequence++, std::move(job)});
+    }
+    jobAvailable.notify_one();
+}
+
+void WorkerPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return jobs.empty() && runningJobs == 0; });
+}
+
+size_t WorkerPool::getQueuedJobCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping)
+                return;
+            work = std::move(const_cast<Job&>(jobs.top()).work);
+            jobs.pop();
+            runningJobs++;
+        }
+
+        work();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            runningJobs--;
+            if (jobs.empty() && runningJobs == 0)
+                idle.notify_all();
+        }
+    }
+}
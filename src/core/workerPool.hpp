@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed-size pool of background threads running prioritised jobs.
+// Jobs must not touch OpenGL or anything the main thread mutates without locking.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threadCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Lower priority values run first, equal priorities run in submission order
+    void submit(int priority, std::function<void()> job);
+
+    // Blocks until every submitted job has finished
+    void waitIdle();
+
+    int getThreadCount() const { return static_cast<int>(threads.size()); }
+    size_t getQueuedJobCount() const;
+
+private:
+    struct Job {
+        int priority;
+        uint64_t sequence;
+        std::function<void()> work;
+    };
+    struct JobOrder {
+        bool operator()(const Job& a, const Job& b) const {
+            if (a.priority != b.priority)
+                return a.priority > b.priority;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    std::priority_queue<Job, std::vector<Job>, JobOrder> jobs;
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable idle;
+    uint64_t nextSequence = 0;
+    int runningJobs = 0;
+    bool stopping = false;
+
+    void workerLoop();
+};
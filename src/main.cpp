@@ -16,6 +16,7 @@
 #include "core/controls.hpp"
 #include "world/modelDB.hpp"
 #include "world/biomeDB.hpp"
+#include "world/blockQuadDB.hpp"
 
 GLFWwindow* g_currentGLFWwindow = nullptr;
 GLFWwindow* getCurrentGLFWwindow() { return g_currentGLFWwindow; }
@@ -38,6 +39,8 @@ int main() {
     BlockDB::init();
     BiomeDB::init();
     ModelDB::init();
+    BlockDB::initProperties();
+    BlockQuadDB::init();
     loadControlsFromFile("controls.txt");
     
     Camera camera(
@@ -7,14 +7,16 @@
 #include <set>
 #include "blockPreviewRenderer.hpp"
 #include "shader.hpp"
+#include "frameData.hpp"
 #include "../world/blockDB.hpp"
 #include "../world/modelDB.hpp"
+#include "../world/chunkVertex.hpp"
 
 GLuint BlockPreviewRenderer::atlas = 0;
 GLuint BlockPreviewRenderer::shaderProgram = 0;
 GLuint BlockPreviewRenderer::fbo = 0;
 GLuint BlockPreviewRenderer::depthRbo = 0;
-std::unordered_map<uint8_t, GLuint> BlockPreviewRenderer::previewTextures;
+std::unordered_map<uint16_t, GLuint> BlockPreviewRenderer::previewTextures;
 
 static const int PREVIEW_SIZE = 64;
 
@@ -26,7 +28,9 @@ static const std::set<std::string> flatRenderModels = {
 GLuint BlockPreviewRenderer::createPreviewShader() {
     std::string vertSrc = loadShaderSource("shaders/vertex.glsl");
     std::string fragSrc = loadShaderSource("shaders/fragment.glsl");
-    return createShaderProgram(vertSrc.c_str(), fragSrc.c_str());
+    GLuint program = createShaderProgram(vertSrc.c_str(), fragSrc.c_str());
+    FrameDataBuffer::bindBlock(program);
+    return program;
 }
 
 void BlockPreviewRenderer::init(GLuint textureAtlas) {
@@ -45,7 +49,7 @@ void BlockPreviewRenderer::init(GLuint textureAtlas) {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-void BlockPreviewRenderer::buildBlockMesh(uint8_t blockId, std::vector<float>& vertices, std::vector<unsigned int>& indices) {
+void BlockPreviewRenderer::buildBlockMesh(uint16_t blockId, std::vector<ChunkVertex>& vertices, std::vector<unsigned int>& indices) {
     const BlockDB::BlockInfo* info = BlockDB::getBlockInfo(blockId);
     if (!info) return;
 
@@ -53,7 +57,6 @@ void BlockPreviewRenderer::buildBlockMesh(uint8_t blockId, std::vector<float>& v
     if (!model) return;
 
     static const char* faceNames[6] = {"north", "south", "west", "east", "up", "down"};
-    constexpr float atlasSize = 16.0f;
     unsigned int offset = 0;
 
     // Render cuboid faces
@@ -120,8 +123,8 @@ void BlockPreviewRenderer::buildBlockMesh(uint8_t blockId, std::vector<float>& v
 
             for (int i = 0; i < 4; ++i) {
                 glm::vec3 pos = faceVerts[i];
-                glm::vec2 uv = (atlasOffset + glm::vec2(faceData.uv[i].first, faceData.uv[i].second)) / atlasSize;
-                vertices.insert(vertices.end(), {pos.x, pos.y, pos.z, uv.x, uv.y, static_cast<float>(face)});
+                glm::vec2 uv(faceData.uv[i].first, faceData.uv[i].second);
+                vertices.push_back(packChunkVertex(pos, atlasOffset, uv, face));
             }
 
             indices.insert(indices.end(), {offset, offset + 1, offset + 2, offset + 2, offset + 3, offset});
@@ -169,8 +172,8 @@ void BlockPreviewRenderer::buildBlockMesh(uint8_t blockId, std::vector<float>& v
                 else if (plane.positionDirection == 'y') pos += glm::vec3(0.0f, plane.positionOffset, 0.0f);
                 else if (plane.positionDirection == 'z') pos += glm::vec3(0.0f, 0.0f, plane.positionOffset);
             }
-            glm::vec2 uv = (atlasOffset + glm::vec2(faceData.uv[i].first, faceData.uv[i].second)) / atlasSize;
-            vertices.insert(vertices.end(), {pos.x, pos.y, pos.z, uv.x, uv.y, 0.0f});
+            glm::vec2 uv(faceData.uv[i].first, faceData.uv[i].second);
+            vertices.push_back(packChunkVertex(pos, atlasOffset, uv, 0));
         }
 
         indices.insert(indices.end(), {offset, offset + 1, offset + 2, offset + 2, offset + 3, offset});
@@ -203,22 +206,36 @@ void BlockPreviewRenderer::generatePreviews() {
     float orthoSize = 0.9f;
     glm::mat4 projection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 0.1f, 10.0f);
 
-    GLint uModelLoc = glGetUniformLocation(shaderProgram, "model");
-    GLint uViewLoc = glGetUniformLocation(shaderProgram, "view");
-    GLint uProjLoc = glGetUniformLocation(shaderProgram, "projection");
+    GLint uChunkPagesLoc = glGetUniformLocation(shaderProgram, "chunkPages");
     GLint uAtlasLoc = glGetUniformLocation(shaderProgram, "atlas");
-    GLint uFogDensityLoc = glGetUniformLocation(shaderProgram, "fogDensity");
-    GLint uCamPosLoc = glGetUniformLocation(shaderProgram, "cameraPos");
 
-    glm::mat4 model = glm::mat4(1.0f);
-
-    for (uint8_t id = 1; id <= 254; id++) {
+    // The previews' own FrameData, the next world frame binds the renderer's again
+    FrameDataBuffer frameData;
+    FrameData frame = {};
+    frame.view = view;
+    frame.cameraPos = eye;
+    frame.fogDensity = 0.0f;
+
+    // vertex.glsl looks up each vertex's chunk in a page table, every preview vertex is in chunk (0, 0).
+    // 64 zeroed pages cover 16k vertices, far more than one block
+    std::vector<int32_t> zeroPages(64 * 2, 0);
+    GLuint pageBuffer, pageTexture;
+    glGenBuffers(1, &pageBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, pageBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, zeroPages.size() * sizeof(int32_t), zeroPages.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glGenTextures(1, &pageTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, pageTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32I, pageBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    for (uint16_t id = 1; id < UINT16_MAX; id++) {
         const auto* blockInfo = BlockDB::getBlockInfo(id);
         if (!blockInfo) continue;
 
         if (flatRenderModels.count(blockInfo->modelName)) continue;
 
-        std::vector<float> vertices;
+        std::vector<ChunkVertex> vertices;
         std::vector<unsigned int> indices;
         buildBlockMesh(id, vertices, indices);
         if (indices.empty()) continue;
@@ -236,18 +253,14 @@ void BlockPreviewRenderer::generatePreviews() {
         glBindVertexArray(vao);
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ChunkVertex), vertices.data(), GL_STATIC_DRAW);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
         glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
 
-        // pos(3), uv(2), faceID(1)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+        // Same packed vertex as the chunk meshes, they share vertex.glsl
+        glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)0);
         glEnableVertexAttribArray(0);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(5 * sizeof(float)));
-        glEnableVertexAttribArray(2);
 
         glBindVertexArray(0);
 
@@ -274,18 +287,17 @@ void BlockPreviewRenderer::generatePreviews() {
         glDisable(GL_CULL_FACE);
 
         glUseProgram(shaderProgram);
-        glUniformMatrix4fv(uModelLoc, 1, GL_FALSE, glm::value_ptr(model));
-        glUniformMatrix4fv(uViewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(uProjLoc, 1, GL_FALSE, glm::value_ptr(projection));
+        frame.projection = projection;
+        frameData.update(frame);
 
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, atlas);
         glUniform1i(uAtlasLoc, 0);
 
-        if (uFogDensityLoc != -1)
-            glUniform1f(uFogDensityLoc, 0.0f);
-        if (uCamPosLoc != -1)
-            glUniform3fv(uCamPosLoc, 1, glm::value_ptr(eye));
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_BUFFER, pageTexture);
+        glUniform1i(uChunkPagesLoc, 1);
+        glActiveTexture(GL_TEXTURE0);
 
         glBindVertexArray(vao);
         glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
@@ -300,6 +312,9 @@ void BlockPreviewRenderer::generatePreviews() {
         glDeleteBuffers(1, &ebo);
     }
 
+    glDeleteTextures(1, &pageTexture);
+    glDeleteBuffers(1, &pageBuffer);
+
     glBindFramebuffer(GL_FRAMEBUFFER, prevFbo);
     glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
     if (prevDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
@@ -308,7 +323,7 @@ void BlockPreviewRenderer::generatePreviews() {
     //glClearColor(0.6f, 1.0f, 1.0f, 1.0f); // Restore default clear color
 }
 
-GLuint BlockPreviewRenderer::getPreviewTexture(uint8_t blockId) {
+GLuint BlockPreviewRenderer::getPreviewTexture(uint16_t blockId) {
     auto it = previewTextures.find(blockId);
     if (it != previewTextures.end()) return it->second;
     return 0;
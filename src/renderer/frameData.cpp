@@ -0,0 +1,24 @@
+#include "frameData.hpp"
+
+FrameDataBuffer::~FrameDataBuffer() {
+    glDeleteBuffers(1, &buffer);
+}
+
+void FrameDataBuffer::bindBlock(GLuint program) {
+    GLuint blockIndex = glGetUniformBlockIndex(program, "FrameData");
+    if (blockIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(program, blockIndex, binding);
+}
+
+void FrameDataBuffer::update(const FrameData& data) {
+    if (buffer == 0) {
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    } else {
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    }
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Values every world shader reads from its FrameData uniform block, written once per frame.
+// Mirrors the std140 layout in the shaders: each vec3 shares its 16 bytes with the float after it
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 fogColor;
+    float fogDensity;          // 0 disables fog
+    glm::vec3 cameraPos;       // What fog distances are measured from, in the space of WorldPos
+    float fogStartDistance;
+    glm::vec3 cameraOffset;    // Camera position inside its chunk
+    float time;
+    glm::ivec2 cameraChunk;
+    glm::ivec2 padding;
+};
+static_assert(sizeof(FrameData) == 192, "FrameData must match the std140 block in the shaders");
+
+// Uniform buffer holding one FrameData, bound to the same binding point every world program uses
+class FrameDataBuffer {
+public:
+    static const GLuint binding = 0;
+
+    FrameDataBuffer() = default;
+    ~FrameDataBuffer();
+
+    FrameDataBuffer(const FrameDataBuffer&) = delete;
+    FrameDataBuffer& operator=(const FrameDataBuffer&) = delete;
+
+    // Points the program's FrameData block at `binding`, programs without the block are left alone
+    static void bindBlock(GLuint program);
+
+    // Uploads the values and binds the buffer, created on first use. GL thread only
+    void update(const FrameData& data);
+
+private:
+    GLuint buffer = 0;
+};
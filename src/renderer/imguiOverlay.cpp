@@ -9,12 +9,13 @@
 #include "../world/block_interaction.hpp"
 #include "../core/input.hpp"
 #include "../core/options.hpp"
+#include "../core/allocationCounter.hpp"
 #include "../core/controls.hpp"
 
 const float ImGuiOverlay::fpsRefreshInterval = 0.5f; // 500ms
 
 std::vector<const char*> ImGuiOverlay::blockItems;
-std::vector<uint8_t> ImGuiOverlay::blockIds;
+std::vector<uint16_t> ImGuiOverlay::blockIds;
 ImTextureID ImGuiOverlay::texAtlas;
 
 static std::vector<std::string> consoleLog;
@@ -171,7 +172,7 @@ bool ImGuiOverlay::init(GLFWwindow* window, GLuint textureAtlas) {
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 330");
 
-    for (uint8_t id = 1; id <= 254; id++) {
+    for (uint16_t id = 1; id < UINT16_MAX; id++) {
         const auto* info = BlockDB::getBlockInfo(id);
         if (info) {
             blockItems.push_back(info->name.c_str());
@@ -438,7 +439,7 @@ void ImGuiOverlay::render(float deltaTime, Camera& camera, World* world, Rendere
         float camPitch = camera.getPitch();
         bool grounded = camera.isGrounded();
 
-        uint8_t selectedBlockType = getSelectedBlockType();
+        uint16_t selectedBlockType = getSelectedBlockType();
         glm::dvec3 velocity = camera.getVelocity();
         float speedHor = static_cast<float>(glm::length(glm::dvec2(velocity.x, velocity.z)));
         float speedVer = static_cast<float>(glm::length(velocity.y));
@@ -462,6 +463,70 @@ void ImGuiOverlay::render(float deltaTime, Camera& camera, World* world, Rendere
         ImGui::Text("Pos: %.2f / %.2f / %.2f", feetPos.x-0.5, feetPos.y, feetPos.z-0.5);
         ImGui::Text("Delta Time: %.2f ms", deltaTime*1000);
         ImGui::Text("Chunk: %d, %d", chunkX, chunkZ);
+        ImGui::Text("Mesher -> Sections skipped: %d / %d", world->getSkippedSectionCount(), static_cast<int>(world->getChunkCount()) * Chunk::sectionCount);
+        Chunk* currentChunk = world->getChunk(chunkX, chunkZ);
+        if (currentChunk) {
+            size_t vertices = currentChunk->getOpaqueVertexCount();
+            size_t unmerged = currentChunk->getUnmergedOpaqueVertexCount();
+            ImGui::Text("Greedy -> Chunk vertices: %zu / %zu per face (%.1f%% fewer)", vertices, unmerged,
+                        unmerged > 0 ? 100.0 * (1.0 - static_cast<double>(vertices) / unmerged) : 0.0);
+        }
+        size_t worldVertices, worldUnmerged;
+        world->getOpaqueVertexCounts(worldVertices, worldUnmerged);
+        ImGui::Text("Greedy -> World vertices: %zu / %zu per face (%.1f%% fewer)", worldVertices, worldUnmerged,
+                    worldUnmerged > 0 ? 100.0 * (1.0 - static_cast<double>(worldVertices) / worldUnmerged) : 0.0);
+        size_t crossInstances = world->getCrossInstanceCount();
+        ImGui::Text("Cross -> Instances: %zu (%.1f KB)", crossInstances, crossInstances * sizeof(uint32_t) / 1024.0);
+        const World::RenderStats& renderStats = world->getRenderStats();
+        ImGui::Text("Render -> Draw calls: %zu (%zu per chunk) / Multi-draw entries: %zu / Visible chunks: %zu",
+                    renderStats.drawCalls, renderStats.perChunkDrawCalls, renderStats.subDraws, renderStats.visibleChunks);
+        const SectionVisibility::Stats& visibilityStats = world->getSectionVisibilityStats();
+        ImGui::Text("Cave culling -> Visible sections: %zu / %zu in frustum%s", visibilityStats.visibleSections,
+                    visibilityStats.frustumSections, visibilityStats.culling ? "" : " (off)");
+        ImGui::Text("Liquid -> Chunks re-sorted: %zu / Indices uploaded: %s", renderStats.liquidSorts,
+                    renderStats.liquidUploaded ? "yes" : "no");
+        MeshArena::Stats opaqueArena = world->getOpaqueArenaStats();
+        MeshArena::Stats crossArena = world->getCrossArenaStats();
+        MeshArena::Stats liquidArena = world->getLiquidArenaStats();
+        ImGui::Text("Arenas -> Opaque: %.1f / %.1f MB / Cross: %.1f / %.1f MB / Liquid: %.1f / %.1f MB / Growths: %zu",
+                    opaqueArena.usedPages * opaqueArena.bytesPerPage / (1024.0 * 1024.0),
+                    opaqueArena.totalPages * opaqueArena.bytesPerPage / (1024.0 * 1024.0),
+                    crossArena.usedPages * crossArena.bytesPerPage / (1024.0 * 1024.0),
+                    crossArena.totalPages * crossArena.bytesPerPage / (1024.0 * 1024.0),
+                    liquidArena.usedPages * liquidArena.bytesPerPage / (1024.0 * 1024.0),
+                    liquidArena.totalPages * liquidArena.bytesPerPage / (1024.0 * 1024.0),
+                    opaqueArena.growths + crossArena.growths + liquidArena.growths);
+        ChunkPool::Stats poolStats = world->getChunkPoolStats();
+        ImGui::Text("Chunk pool -> Hits: %zu / Misses: %zu / Pooled: %zu / %zu", poolStats.hits, poolStats.misses, poolStats.pooled, poolStats.capacity);
+        ImGui::Text("Chunk pool -> Releases: %zu / Evictions: %zu", poolStats.releases, poolStats.evictions);
+        ImGui::Text("World gen -> Threads: %d / Generating: %zu", world->getWorldgenThreadCount(), world->getGeneratingChunkCount());
+        ChunkLoadQueue::Stats loadStats = world->getLoadQueueStats();
+        ImGui::Text("Load queue -> Pending: %zu / Enqueued: %zu / Cancelled: %zu / Completed: %zu",
+                    loadStats.pending, loadStats.enqueued, loadStats.cancelled, loadStats.completed);
+        ImGui::Text("Load queue -> Wait: %.1f ms avg / %.1f ms max", loadStats.averageWaitMs, loadStats.maxWaitMs);
+        const World::MeshStats& meshStats = world->getMeshStats();
+        ImGui::Text("Meshing -> In flight: %d / Awaiting upload: %zu", meshStats.inFlight, meshStats.awaitingUpload);
+        ImGui::Text("Meshing -> Mesher: %s / AO: %s / Build: %.3f ms avg",
+                    Chunk::usesBinaryMesher() ? "binary" : "per face",
+                    Chunk::usesAmbientOcclusion() ? "on" : "off",
+                    meshStats.meshesBuilt ? meshStats.meshBuildMs / meshStats.meshesBuilt : 0.0);
+        if (AllocationCounter::isEnabled())
+            ImGui::Text("Meshing -> Heap allocations: %zu / Jobs created: %zu / Idle jobs: %zu",
+                        AllocationCounter::getCount(), meshStats.meshJobsCreated, meshStats.idleMeshJobs);
+        else
+            ImGui::Text("Meshing -> Heap allocations: count_allocations=0 / Jobs created: %zu / Idle jobs: %zu",
+                        meshStats.meshJobsCreated, meshStats.idleMeshJobs);
+        ImGui::Text("Meshing -> Uploaded: %zu (%.1f KB last frame) / Stale sections dropped: %zu",
+                    meshStats.uploaded, meshStats.uploadedBytesLastFrame / 1024.0, meshStats.droppedStale);
+        ImGui::Text("Remesh -> Requested: %zu / Performed: %zu / Sections: %zu / Dirty: %zu",
+                    meshStats.rebuildsRequested, meshStats.rebuildsPerformed, meshStats.sectionsRebuilt, meshStats.dirtyChunks);
+        MeshCache::Stats cacheStats = world->getMeshCacheStats();
+        ImGui::Text("Mesh cache -> Hit rate: %.1f%% (%zu / %zu) / Entries: %zu / Evictions: %zu",
+                    cacheStats.lookups ? 100.0 * cacheStats.hits / cacheStats.lookups : 0.0,
+                    cacheStats.hits, cacheStats.lookups, cacheStats.entries, cacheStats.evictions);
+        ImGui::Text("Mesh cache -> Memory: %.1f / %.1f MB / Hit copy: %.3f ms avg",
+                    cacheStats.bytes / (1024.0 * 1024.0), cacheStats.capacityBytes / (1024.0 * 1024.0),
+                    meshStats.meshCacheHits ? meshStats.meshCacheHitMs / meshStats.meshCacheHits : 0.0);
         ImGui::Separator();
         ImGui::Text("Camera -> Yaw: %.2f", camYaw);
         ImGui::Text("Camera -> Pitch: %.2f", camPitch);
@@ -672,7 +737,7 @@ void ImGuiOverlay::render(float deltaTime, Camera& camera, World* world, Rendere
         ImDrawList* drawList = ImGui::GetWindowDrawList();
 
         for (size_t i = 0; i < hotbarBlocks.size(); i++) {
-            uint8_t blockId = hotbarBlocks[i];
+            uint16_t blockId = hotbarBlocks[i];
             const auto* blockInfo = BlockDB::getBlockInfo(blockId);
             if (!blockInfo) continue;
 
@@ -795,6 +860,7 @@ void ImGuiOverlay::render(float deltaTime, Camera& camera, World* world, Rendere
                     consoleLog.push_back("  help - Show this help page");
                     consoleLog.push_back("  tp <x> <y> <z> - Teleport to coordinates");
                     consoleLog.push_back("  edgelands - Teleport to the edge of the world");
+                    consoleLog.push_back("  benchmark - Compare chunk lookup cost against std::map");
                 } else if (input.rfind("tp", 0) == 0) {
                     std::istringstream ss(input);
                     std::string cmd, coordx, coordy, coordz;
@@ -841,6 +907,13 @@ void ImGuiOverlay::render(float deltaTime, Camera& camera, World* world, Rendere
                 }*/ else if (input == "edgelands"){
                     camera.setPosition(glm::dvec3(2147483635.0, 100.0, 0));
                     consoleLog.push_back("Do not step on blocks right at the edge (game will crash)");
+                } else if (input == "benchmark") {
+                    ChunkLookupBenchmark bench = benchmarkChunkLookup(world->getChunks(), 1000000);
+                    char buf[160];
+                    snprintf(buf, sizeof(buf), "Chunk lookup (%d lookups, %zu chunks): std::map %.2f ns, ChunkMap %.2f ns%s",
+                             bench.lookups, world->getChunkCount(), bench.mapNanoseconds, bench.chunkMapNanoseconds,
+                             bench.matched ? "" : " (results differ!)");
+                    consoleLog.push_back(buf);
                 } else {
                     consoleLog.push_back("Unknown command. Type 'help' for a list of commands.");
                 }
@@ -19,7 +19,7 @@ extern bool consoleOpen;
 extern bool hotbarOpen;
 
 extern int selectedHotbarIndex;
-extern std::array<uint8_t, 9> hotbarBlocks;
+extern std::array<uint16_t, 9> hotbarBlocks;
 
 class ImGuiOverlay {
 public:
@@ -30,7 +30,7 @@ public:
     void render(float deltaTime, Camera& camera, class World* world, Renderer* renderer);
 
     static std::vector<const char*> blockItems;
-    static std::vector<uint8_t> blockIds;
+    static std::vector<uint16_t> blockIds;
     static ImTextureID texAtlas;
 
     std::unordered_map<std::string, std::vector<size_t>> tabMap;
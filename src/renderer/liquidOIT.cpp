@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+#include "liquidOIT.hpp"
+#include "shader.hpp"
+
+LiquidOIT::~LiquidOIT() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &accumulationTexture);
+    glDeleteTextures(1, &weightTexture);
+    glDeleteRenderbuffers(1, &depthRenderbuffer);
+    glDeleteProgram(compositeProgram);
+    glDeleteVertexArrays(1, &compositeVAO);
+}
+
+void LiquidOIT::init() {
+    std::string vertexSource = loadShaderSource("shaders/oit_composite_vertex.glsl");
+    std::string fragmentSource = loadShaderSource("shaders/oit_composite_fragment.glsl");
+    compositeProgram = createShaderProgram(vertexSource.c_str(), fragmentSource.c_str());
+    glUseProgram(compositeProgram);
+    glUniform1i(glGetUniformLocation(compositeProgram, "accumulation"), 0);
+    glUniform1i(glGetUniformLocation(compositeProgram, "weight"), 1);
+    glUseProgram(0);
+
+    glGenVertexArrays(1, &compositeVAO);
+}
+
+void LiquidOIT::resize(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+
+    if (framebuffer == 0) {
+        glGenFramebuffers(1, &framebuffer);
+        glGenTextures(1, &accumulationTexture);
+        glGenTextures(1, &weightTexture);
+        glGenRenderbuffers(1, &depthRenderbuffer);
+    }
+
+    const GLuint textures[2] = {accumulationTexture, weightTexture};
+    const GLint formats[2] = {GL_RGBA16F, GL_R16F};
+    const GLenum channels[2] = {GL_RGBA, GL_RED};
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, textures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, formats[i], width, height, 0, channels[i], GL_HALF_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Same format as the default framebuffer's depth, so the scene depth can be blitted over
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumulationTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, weightTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRenderbuffer);
+    const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(2, drawBuffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Liquid OIT framebuffer is incomplete" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void LiquidOIT::begin() {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (viewport[2] != width || viewport[3] != height)
+        resize(viewport[2], viewport[3]);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    const GLfloat clearAccumulation[4] = {0.0f, 0.0f, 0.0f, 1.0f}; // Nothing accumulated, fully revealed
+    const GLfloat clearWeight[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glClearBufferfv(GL_COLOR, 0, clearAccumulation);
+    glClearBufferfv(GL_COLOR, 1, clearWeight);
+
+    glDepthMask(GL_FALSE);
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void LiquidOIT::composite() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_DEPTH_TEST);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(compositeProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, accumulationTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, weightTexture);
+    glBindVertexArray(compositeVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    glEnable(GL_DEPTH_TEST);
+}
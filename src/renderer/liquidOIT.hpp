@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Weighted blended order-independent transparency for the liquid pass, picked with `liquid_oit=1`.
+// Liquid faces accumulate into two targets instead of blending over the scene in sorted order:
+//   accumulation (RGBA16F): rgb sums color * alpha * weight, alpha multiplies to the revealage, prod(1 - alpha)
+//   weight (R16F):          sums alpha * weight
+// Both come from one glBlendFuncSeparate(ONE, ONE, ZERO, ONE_MINUS_SRC_ALPHA), which GL 3.3 can do without
+// per-target blending. composite() then blends the weighted average color over the scene by 1 - revealage.
+// Weights fall off with distance, see liquid_oit_fragment.glsl
+class LiquidOIT {
+public:
+    LiquidOIT() = default;
+    ~LiquidOIT();
+
+    LiquidOIT(const LiquidOIT&) = delete;
+    LiquidOIT& operator=(const LiquidOIT&) = delete;
+
+    // Compiles the composite program. GL thread only
+    void init();
+    // Copies the scene depth so liquid behind terrain is rejected, then binds and clears the targets and
+    // sets up the accumulation blending. Targets follow the viewport size
+    void begin();
+    // Back on the default framebuffer, blends the resolved liquid over the scene and restores the usual blending
+    void composite();
+
+private:
+    GLuint framebuffer = 0;
+    GLuint accumulationTexture = 0;
+    GLuint weightTexture = 0;
+    GLuint depthRenderbuffer = 0;
+    GLuint compositeProgram = 0;
+    GLuint compositeVAO = 0; // Attributeless, the vertex shader makes a fullscreen triangle
+    int width = 0, height = 0;
+
+    void resize(int newWidth, int newHeight);
+};
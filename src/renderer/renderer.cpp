@@ -2,6 +2,7 @@
 #include <GLFW/glfw3.h>
 #include <stb_image.h>
 #include <iostream>
+#include <cmath>
 #include <glm/gtc/type_ptr.hpp>
 #include "renderer.hpp"
 #include "shader.hpp"
@@ -16,6 +17,7 @@ Renderer::Renderer() : shaderProgram(0), textureAtlas(0), crosshairVAO(0), cross
 Renderer::~Renderer() {
     glDeleteTextures(1, &textureAtlas);
     glDeleteProgram(shaderProgram);
+    glDeleteProgram(liquidOITShaderProgram);
 
     glDeleteVertexArrays(1, &crosshairVAO);
     glDeleteBuffers(1, &crosshairVBO);
@@ -47,6 +49,10 @@ void Renderer::init() {
     std::string liquidVertexSource = loadShaderSource("shaders/liquid_vertex.glsl");
     std::string liquidFragmentSource = loadShaderSource("shaders/liquid_fragment.glsl");
     liquidShaderProgram = createShaderProgram(liquidVertexSource.c_str(), liquidFragmentSource.c_str());
+    std::string liquidOITFragmentSource = loadShaderSource("shaders/liquid_oit_fragment.glsl");
+    liquidOITShaderProgram = createShaderProgram(liquidVertexSource.c_str(), liquidOITFragmentSource.c_str());
+    liquidOITEnabled = getOptionInt("liquid_oit", 0) != 0;
+    liquidOIT.init();
     
     std::string crosshairVertexSource = loadShaderSource("shaders/crosshair_vertex.glsl");
     std::string crosshairFragmentSource = loadShaderSource("shaders/crosshair_fragment.glsl");
@@ -57,38 +63,22 @@ void Renderer::init() {
     borderShaderProgram = createShaderProgram(borderVertexSource.c_str(), borderFragmentSource.c_str());
 
     uCrosshairAspectLoc = glGetUniformLocation(crosshairShaderProgram, "aspectRatio");
-
-    uCrossModelLoc = glGetUniformLocation(crossShaderProgram, "model");
-    uCrossViewLoc = glGetUniformLocation(crossShaderProgram, "view");
-    uCrossProjLoc = glGetUniformLocation(crossShaderProgram, "projection");
-    uCrossAtlasLoc = glGetUniformLocation(crossShaderProgram, "atlas");
-    uCrossFogDensityLoc = glGetUniformLocation(crossShaderProgram, "fogDensity");
-    uCrossFogStartLoc = glGetUniformLocation(crossShaderProgram, "fogStartDistance");
-    uCrossFogColorLoc = glGetUniformLocation(crossShaderProgram, "fogColor");
-    uCrossCamPosLoc = glGetUniformLocation(crossShaderProgram, "cameraPos");
-
-    uLiquidModelLoc = glGetUniformLocation(liquidShaderProgram, "model");
-    uLiquidViewLoc = glGetUniformLocation(liquidShaderProgram, "view");
-    uLiquidProjLoc = glGetUniformLocation(liquidShaderProgram, "projection");
-    uLiquidAtlasLoc = glGetUniformLocation(liquidShaderProgram, "atlas");
-    uLiquidTimeLoc = glGetUniformLocation(liquidShaderProgram, "time");
-    uLiquidFogDensityLoc = glGetUniformLocation(liquidShaderProgram, "fogDensity");
-    uLiquidFogStartLoc = glGetUniformLocation(liquidShaderProgram, "fogStartDistance");
-    uLiquidFogColorLoc = glGetUniformLocation(liquidShaderProgram, "fogColor");
-    uLiquidCamPosLoc = glGetUniformLocation(liquidShaderProgram, "cameraPos");
-
     uBorderModelLoc = glGetUniformLocation(borderShaderProgram, "model");
-    uBorderViewLoc = glGetUniformLocation(borderShaderProgram, "view");
-    uBorderProjLoc = glGetUniformLocation(borderShaderProgram, "projection");
-
-    uModelLoc = glGetUniformLocation(shaderProgram, "model");
-    uViewLoc = glGetUniformLocation(shaderProgram, "view");
-    uProjLoc = glGetUniformLocation(shaderProgram, "projection");
-    uAtlasLoc = glGetUniformLocation(shaderProgram, "atlas");
-    uFogDensityLoc = glGetUniformLocation(shaderProgram, "fogDensity");
-    uFogStartLoc = glGetUniformLocation(shaderProgram, "fogStartDistance");
-    uFogColorLoc = glGetUniformLocation(shaderProgram, "fogColor");
-    uCamPosLoc = glGetUniformLocation(shaderProgram, "cameraPos");
+
+    // Everything else shared comes from the FrameData block, the samplers never change units
+    for (GLuint program : {shaderProgram, crossShaderProgram, liquidShaderProgram, liquidOITShaderProgram, borderShaderProgram}) {
+        FrameDataBuffer::bindBlock(program);
+    }
+    for (GLuint program : {shaderProgram, crossShaderProgram, liquidShaderProgram, liquidOITShaderProgram}) {
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "atlas"), 0);
+        glUniform1i(glGetUniformLocation(program, "chunkPages"), World::pageTextureUnit);
+    }
+    glUseProgram(crossShaderProgram);
+    glUniform1i(glGetUniformLocation(crossShaderProgram, "crossTemplates"), 1);
+    glUniform1i(glGetUniformLocation(crossShaderProgram, "crossInstances"), World::crossInstanceTextureUnit);
+    glUniform1i(glGetUniformLocation(crossShaderProgram, "verticesPerInstance"), CrossMesh::getVerticesPerInstance());
+    glUseProgram(0);
 
     loadTextureAtlas("textures/atlas.png");
     initCrosshair();
@@ -168,7 +158,9 @@ void Renderer::renderWorld(const Camera& camera, float aspectRatio, float deltaT
     glEnable(GL_DEPTH_TEST);
     int renderDist = getOptionInt("render_distance", 7) + 1; // +1 to account for invisible "mesh helper" chunk
     fogStartDistance = ((getOptionFloat("render_distance", 7) + 1) * 16) - 20;
+    world.setViewDirection(camera.getFront());
     world.updateChunksAroundPlayer(camera.getPositionDouble(), renderDist);
+    world.uploadMeshes();
 
     GLFWwindow* getCurrentGLFWwindow();
     GLFWwindow* window = getCurrentGLFWwindow();
@@ -197,90 +189,62 @@ void Renderer::renderWorld(const Camera& camera, float aspectRatio, float deltaT
     
     Frustum frustum = World::extractFrustumPlanes(projection * view);
 
-    glm::vec3 camPos = camera.getPosition();
+    // Chunk meshes are placed relative to the camera's chunk, the offset inside it is taken in double precision
+    glm::dvec3 camPosDouble = camera.getPositionDouble();
+    glm::ivec2 cameraChunk(static_cast<int>(std::floor(camPosDouble.x / Chunk::chunkWidth)),
+                           static_cast<int>(std::floor(camPosDouble.z / Chunk::chunkDepth)));
+
+    FrameData frame;
+    frame.view = view;
+    frame.projection = projection;
+    frame.fogColor = fogColor;
+    frame.fogDensity = fogEnabled ? fogDensity : 0.0f; // 0 disables fog
+    frame.cameraPos = glm::vec3(0.0f); // WorldPos is already relative to the camera
+    frame.fogStartDistance = fogStartDistance;
+    frame.cameraOffset = glm::vec3(camPosDouble - glm::dvec3(cameraChunk.x * Chunk::chunkWidth, 0.0, cameraChunk.y * Chunk::chunkDepth));
+    frame.time = currentFrame;
+    frame.cameraChunk = cameraChunk;
+    frame.padding = glm::ivec2(0);
+    frameData.update(frame);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textureAtlas);
 
     // -------------------------------- Render main --------------------------------
 
     glUseProgram(shaderProgram);
     glEnable(GL_CULL_FACE);
     glEnable(GL_BLEND);
-    
-    glUniformMatrix4fv(uViewLoc, 1, GL_FALSE, &view[0][0]);
-    glUniformMatrix4fv(uProjLoc, 1, GL_FALSE, &projection[0][0]);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureAtlas);
-    glUniform1i(uAtlasLoc, 0);
-
-    if (uCamPosLoc != -1) {
-        glUniform3fv(uCamPosLoc, 1, glm::value_ptr(glm::vec3(0.0f)));
-    }
-
-    if (fogEnabled) {
-        glUniform1f(uFogDensityLoc, fogDensity);
-        glUniform1f(uFogStartLoc, fogStartDistance);
-        glUniform3fv(uFogColorLoc, 1, glm::value_ptr(fogColor));
-    } else {
-        glUniform1f(uFogDensityLoc, 0.0f); // Disable fog
-    }
 
-    world.render(camera, uModelLoc, frustum);
+    world.cullSections(camera, frustum);
+    world.render();
 
     // -------------------------------- Render cross --------------------------------
 
     glUseProgram(crossShaderProgram);
     glDisable(GL_CULL_FACE);
 
-    glUniformMatrix4fv(uCrossViewLoc, 1, GL_FALSE, &view[0][0]);
-    glUniformMatrix4fv(uCrossProjLoc, 1, GL_FALSE, &projection[0][0]);
-
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, CrossMesh::getTemplateTexture());
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureAtlas);
-    glUniform1i(uCrossAtlasLoc, 0);
 
-    if (uCrossCamPosLoc != -1) {
-        glUniform3fv(uCrossCamPosLoc, 1, glm::value_ptr(glm::vec3(0.0f)));
-    }
-
-    if (fogEnabled) {
-        glUniform1f(uCrossFogDensityLoc, fogDensity);
-        glUniform1f(uCrossFogStartLoc, fogStartDistance);
-        glUniform3fv(uCrossFogColorLoc, 1, glm::value_ptr(fogColor));
-    } else {
-        glUniform1f(uCrossFogDensityLoc, 0.0f); // Disable fog
-    }
-    
-    world.renderCross(camera, uCrossModelLoc, frustum);
+    world.renderCross();
 
     // -------------------------------- Render liquid --------------------------------
 
-    glUseProgram(liquidShaderProgram);
-
-    glUniformMatrix4fv(uLiquidViewLoc, 1, GL_FALSE, &view[0][0]);
-    glUniformMatrix4fv(uLiquidProjLoc, 1, GL_FALSE, &projection[0][0]);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureAtlas);
-    glUniform1i(uLiquidAtlasLoc, 0);
-    glUniform1f(uLiquidTimeLoc, currentFrame);
-
-    if (uLiquidCamPosLoc != -1) {
-        glUniform3fv(uLiquidCamPosLoc, 1, glm::value_ptr(glm::vec3(0.0f)));
-    }
-
-    if (fogEnabled) {
-        glUniform1f(uLiquidFogDensityLoc, fogDensity);
-        glUniform1f(uLiquidFogStartLoc, fogStartDistance);
-        glUniform3fv(uLiquidFogColorLoc, 1, glm::value_ptr(fogColor));
+    if (liquidOITEnabled) {
+        liquidOIT.begin();
+        glUseProgram(liquidOITShaderProgram);
+        world.renderLiquid(camera, false);
+        liquidOIT.composite();
     } else {
-        glUniform1f(uLiquidFogDensityLoc, 0.0f); // Disable fog
+        glUseProgram(liquidShaderProgram);
+        world.renderLiquid(camera);
     }
 
-    world.renderLiquid(camera, uLiquidModelLoc, frustum);
-
     // -------------------- Render selected block border --------------------
     glEnable(GL_DEPTH_TEST);
-    renderSelectedBlockBorder(camera, aspectRatio);
+    renderSelectedBlockBorder(camera);
 
     glDisable(GL_BLEND);
 }
@@ -299,7 +263,7 @@ void Renderer::renderCrosshair(float aspectRatio) {
 }
 
 
-void Renderer::renderSelectedBlockBorder(const Camera& camera, float aspectRatio) {
+void Renderer::renderSelectedBlockBorder(const Camera& camera) {
     RaycastResult hit = raycast(&world, camera.getPositionDouble(), camera.getFront(), 6.0f);
     if (!hit.hit || !hit.hitChunk) return;
 
@@ -309,14 +273,7 @@ void Renderer::renderSelectedBlockBorder(const Camera& camera, float aspectRatio
         hit.hitChunk->chunkZ * Chunk::chunkDepth + hit.hitBlockPos.z
     );
 
-    glm::mat4 view = camera.getViewMatrix();
-    glm::mat4 projection = glm::perspective(
-        glm::radians(currentFov),
-        aspectRatio,
-        0.1f,
-        5000.0f
-    );
-
+    // View and projection are still bound from renderWorld()'s FrameData
     glUseProgram(borderShaderProgram);
 
     glDisable(GL_CULL_FACE);
@@ -332,8 +289,6 @@ void Renderer::renderSelectedBlockBorder(const Camera& camera, float aspectRatio
     model = glm::scale(model, glm::vec3(1.001f));
 
     glUniformMatrix4fv(uBorderModelLoc, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(uBorderViewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(uBorderProjLoc, 1, GL_FALSE, glm::value_ptr(projection));
 
     glBindVertexArray(borderVAO);
     glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, 0);
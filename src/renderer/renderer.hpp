@@ -2,23 +2,19 @@
 
 #include <string>
 #include "../world/world.hpp"
+#include "frameData.hpp"
+#include "liquidOIT.hpp"
 
 class Renderer {
 public:
-    GLint uModelLoc, uViewLoc, uProjLoc, uAtlasLoc, uCrosshairAspectLoc, uFogDensityLoc, uFogStartLoc, uFogColorLoc, uCamPosLoc;
-    GLint uCrossModelLoc, uCrossViewLoc, uCrossProjLoc, uCrossAtlasLoc;
-    GLint uLiquidModelLoc, uLiquidViewLoc, uLiquidProjLoc, uLiquidAtlasLoc;
-    GLint uBorderModelLoc, uBorderViewLoc, uBorderProjLoc;
-    GLint uLiquidTimeLoc, uCrossTimeLoc, uTimeLoc;
-    GLint uLiquidFogDensityLoc, uLiquidFogStartLoc, uLiquidFogColorLoc, uLiquidCamPosLoc;
-    GLint uCrossFogDensityLoc, uCrossFogStartLoc, uCrossFogColorLoc, uCrossCamPosLoc;
+    GLint uCrosshairAspectLoc, uBorderModelLoc;
     Renderer();
     ~Renderer();
 
     void init();
     void renderWorld(const class Camera& camera, float aspectRatio, float deltaTime, float currentFrame);
     void renderCrosshair(float aspectRatio);
-    void renderSelectedBlockBorder(const class Camera& camera, float aspectRatio);
+    void renderSelectedBlockBorder(const class Camera& camera);
 
     World world;
     float currentFov;
@@ -32,8 +28,12 @@ private:
     GLuint shaderProgram;
     GLuint crossShaderProgram;
     GLuint liquidShaderProgram;
+    GLuint liquidOITShaderProgram = 0;
+    bool liquidOITEnabled = false; // `liquid_oit` option, weighted blended liquid instead of sorted
+    LiquidOIT liquidOIT;
     GLuint crosshairVAO, crosshairVBO, crosshairShaderProgram;
     GLuint borderVAO, borderVBO, borderShaderProgram;
+    FrameDataBuffer frameData; // View, projection, fog and camera for every world program
     GLuint createShader(const char* source, GLenum shaderType);
     GLuint createShaderProgram(const char* vertexSource, const char* fragmentSource);
     void loadTextureAtlas(const std::string& path);
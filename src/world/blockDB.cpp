@@ -1,11 +1,19 @@
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <nlohmannJSON/json.hpp>
 #include "blockDB.hpp"
+#include "modelDB.hpp"
 #include "../core/options.hpp"
 
-std::unordered_map<uint8_t, BlockDB::BlockInfo> BlockDB::blockData;
+std::unordered_map<uint16_t, BlockDB::BlockInfo> BlockDB::blockData;
+std::array<uint16_t, 65536> BlockDB::flags{};
+uint8_t BlockDB::faceVisibility[1 << BlockDB::cullingFlagCount][1 << BlockDB::cullingFlagCount];
+std::vector<std::vector<BlockDB::Box>> BlockDB::collisionBoxes;
+std::vector<std::vector<BlockDB::Box>> BlockDB::hitBoxes;
+const std::vector<BlockDB::Box> BlockDB::unknownBoxes = {{glm::vec3(0.0f), glm::vec3(1.0f)}};
+const std::vector<BlockDB::Box> BlockDB::noBoxes;
 
 void BlockDB::init() {
     blockData.clear();
@@ -49,7 +57,7 @@ void BlockDB::init() {
 
                 if (!obj.contains("id")) continue;
                 int id = obj["id"].get<int>();
-                if (id < 0 || id > 255) continue;
+                if (id < 0 || id > UINT16_MAX) continue;
 
                 BlockInfo info;
                 for (int t = 0; t < 6; t++)
@@ -132,14 +140,93 @@ void BlockDB::init() {
         if (!chosen)
             chosen = &vec[0];
 
-        blockData[(uint8_t)chosen->id] = chosen->info;
+        blockData[(uint16_t)chosen->id] = chosen->info;
     }
 }
 
-const BlockDB::BlockInfo* BlockDB::getBlockInfo(const uint8_t& blockName) {
+const BlockDB::BlockInfo* BlockDB::getBlockInfo(uint16_t blockName) {
     auto iterator = blockData.find(blockName);
     if (iterator != blockData.end()) {
         return &iterator->second;
     }
     return nullptr;
 }
+
+// Face culling rules between two blocks, only looks at the culling flags
+static bool isFaceVisible(uint16_t thisFlags, uint16_t neighborFlags, int face, bool fasterTrees) {
+    if (!(thisFlags & BlockDB::Known) || !(neighborFlags & BlockDB::Known))
+        return true;
+
+    if (!fasterTrees && (thisFlags & BlockDB::RenderFacesInBetween))
+        return true;
+
+    if (!(thisFlags & BlockDB::CullingShape) || !(neighborFlags & BlockDB::CullingShape))
+        return true;
+
+    bool thisLiquid = thisFlags & BlockDB::Liquid;
+    bool neighborLiquid = neighborFlags & BlockDB::Liquid;
+    if ((neighborLiquid && !thisLiquid) || (thisLiquid && !neighborLiquid && face == 4))
+        return true;
+
+    if ((neighborFlags & BlockDB::Transparent) && !(thisFlags & BlockDB::Transparent))
+        return true;
+
+    return false;
+}
+
+void BlockDB::initProperties() {
+    flags.fill(0);
+    collisionBoxes.clear();
+    hitBoxes.clear();
+
+    bool fasterTrees = (getOptionInt("faster_trees", 0) != 0);
+    uint16_t maxId = 0;
+    for (const auto& [id, info] : blockData)
+        maxId = std::max(maxId, id);
+    collisionBoxes.assign(maxId + 1, unknownBoxes);
+    hitBoxes.assign(maxId + 1, noBoxes);
+    collisionBoxes[0].clear(); // Air
+
+    for (const auto& [id, info] : blockData) {
+        if (id == 0) continue;
+        const Model* model = ModelDB::getModel(info.modelName);
+
+        uint16_t blockFlags = Known;
+        if (info.modelName == "cube" || info.modelName == "liquid") blockFlags |= CullingShape;
+        if (info.liquid) blockFlags |= Liquid;
+        if (info.transparent) blockFlags |= Transparent;
+        if (info.renderFacesInBetween) blockFlags |= RenderFacesInBetween;
+        if (info.renderFacesInBetween && !fasterTrees) blockFlags |= KeepsInnerFaces;
+        if (model && !model->planes.empty()) blockFlags |= HasPlanes;
+        if (info.modelName == "cube" && model && model->planes.empty() && model->cuboids.size() == 1 &&
+            model->cuboids[0].from == glm::vec3(0.0f) && model->cuboids[0].to == glm::vec3(1.0f))
+            blockFlags |= FullCube;
+        if (info.modelName == "cube" && !info.transparent && !info.liquid && !info.renderFacesInBetween)
+            blockFlags |= Opaque;
+
+        std::vector<Box>& collisions = collisionBoxes[id];
+        collisions.clear();
+        if (ModelDB::getCollisionBoxes(info.modelName, collisions))
+            blockFlags |= HasCollision;
+        else
+            collisions = unknownBoxes;
+
+        std::vector<Box>& hits = hitBoxes[id];
+        if (!ModelDB::getHitBoxes(info.modelName, hits) || hits.empty())
+            hits = unknownBoxes;
+
+        flags[id] = blockFlags;
+    }
+
+    // Unknown IDs and air have no flags, so they end up in row/column 0 and show every face
+    for (int thisFlags = 0; thisFlags < (1 << cullingFlagCount); thisFlags++) {
+        for (int neighborFlags = 0; neighborFlags < (1 << cullingFlagCount); neighborFlags++) {
+            uint8_t visibleFaces = 0;
+            for (int face = 0; face < 6; face++) {
+                if (::isFaceVisible(thisFlags, neighborFlags, face, fasterTrees))
+                    visibleFaces |= 1 << face;
+            }
+            faceVisibility[thisFlags][neighborFlags] = visibleFaces;
+        }
+    }
+}
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <unordered_map>
 #include <array>
 #include <string>
+#include <utility>
 #include <vector>
 
 class BlockDB {
@@ -19,9 +21,52 @@ public:
         std::string tabName;
     };
 
+    using Box = std::pair<glm::vec3, glm::vec3>;
+
+    // Per block property bits. The low five decide face culling
+    enum Flags : uint16_t {
+        Known                = 1 << 0, // Has a BlockInfo, never set for air
+        CullingShape         = 1 << 1, // "cube" or "liquid" model, hides faces of touching blocks of the same kind
+        Liquid               = 1 << 2,
+        Transparent          = 1 << 3,
+        RenderFacesInBetween = 1 << 4,
+        FullCube             = 1 << 5, // "cube" model made of one unit cuboid
+        Opaque               = 1 << 6, // Full cube that hides everything behind it
+        HasCollision         = 1 << 7,
+        HasPlanes            = 1 << 8,
+        KeepsInnerFaces      = 1 << 9  // renderFacesInBetween while faster_trees is off, never culled
+    };
+    static const int cullingFlagCount = 5;
+
     static void init();
-    static const BlockInfo* getBlockInfo(const uint8_t& blockName);
+    // Fills the dense property tables below, call after ModelDB::init()
+    static void initProperties();
+    static const BlockInfo* getBlockInfo(uint16_t blockName);
+
+    static uint16_t getFlags(uint16_t type) { return flags[type]; }
+    static bool hasFlags(uint16_t type, uint16_t mask) { return (flags[type] & mask) == mask; }
+
+    // Whether `face` of `type` shows next to `neighbor`, air and unknown neighbours always show it
+    static bool isFaceVisible(uint16_t type, uint16_t neighbor, int face) {
+        int cullingMask = (1 << cullingFlagCount) - 1;
+        return (faceVisibility[flags[type] & cullingMask][flags[neighbor] & cullingMask] >> face) & 1;
+    }
+
+    static const std::vector<Box>& getCollisionBoxes(uint16_t type) {
+        return type < collisionBoxes.size() ? collisionBoxes[type] : unknownBoxes;
+    }
+    static const std::vector<Box>& getHitBoxes(uint16_t type) {
+        return type < hitBoxes.size() ? hitBoxes[type] : noBoxes;
+    }
 
 private:
-    static std::unordered_map<uint8_t, BlockInfo> blockData;
+    static std::unordered_map<uint16_t, BlockInfo> blockData;
+
+    // Dense tables indexed by block ID, built by initProperties()
+    static std::array<uint16_t, 65536> flags;
+    static uint8_t faceVisibility[1 << cullingFlagCount][1 << cullingFlagCount]; // Visible face bits per [this][neighbour] culling flags
+    static std::vector<std::vector<Box>> collisionBoxes;
+    static std::vector<std::vector<Box>> hitBoxes;
+    static const std::vector<Box> unknownBoxes; // Unit cube, unknown IDs stay solid
+    static const std::vector<Box> noBoxes;
 };
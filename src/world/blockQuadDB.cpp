@@ -0,0 +1,160 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <algorithm>
+#include "blockQuadDB.hpp"
+#include "blockDB.hpp"
+#include "modelDB.hpp"
+
+std::vector<BlockQuads> BlockQuadDB::table;
+
+void getCuboidFaceVertices(int face, const glm::vec3& from, const glm::vec3& to, glm::vec3 out[4]) {
+    switch (face) {
+        case 0: // north (z+)
+            out[0] = glm::vec3(from.x, from.y, to.z);
+            out[1] = glm::vec3(to.x, from.y, to.z);
+            out[2] = glm::vec3(to.x, to.y, to.z);
+            out[3] = glm::vec3(from.x, to.y, to.z);
+            break;
+        case 1: // south (z-)
+            out[0] = glm::vec3(to.x, from.y, from.z);
+            out[1] = glm::vec3(from.x, from.y, from.z);
+            out[2] = glm::vec3(from.x, to.y, from.z);
+            out[3] = glm::vec3(to.x, to.y, from.z);
+            break;
+        case 2: // west (x-)
+            out[0] = glm::vec3(from.x, from.y, from.z);
+            out[1] = glm::vec3(from.x, from.y, to.z);
+            out[2] = glm::vec3(from.x, to.y, to.z);
+            out[3] = glm::vec3(from.x, to.y, from.z);
+            break;
+        case 3: // east (x+)
+            out[0] = glm::vec3(to.x, from.y, to.z);
+            out[1] = glm::vec3(to.x, from.y, from.z);
+            out[2] = glm::vec3(to.x, to.y, from.z);
+            out[3] = glm::vec3(to.x, to.y, to.z);
+            break;
+        case 4: // up (y+)
+            out[0] = glm::vec3(from.x, to.y, to.z);
+            out[1] = glm::vec3(to.x, to.y, to.z);
+            out[2] = glm::vec3(to.x, to.y, from.z);
+            out[3] = glm::vec3(from.x, to.y, from.z);
+            break;
+        case 5: // down (y-)
+            out[0] = glm::vec3(from.x, from.y, from.z);
+            out[1] = glm::vec3(to.x, from.y, from.z);
+            out[2] = glm::vec3(to.x, from.y, to.z);
+            out[3] = glm::vec3(from.x, from.y, to.z);
+            break;
+    }
+}
+
+static void compilePlanes(const Model& model, const BlockDB::BlockInfo& info, BlockQuads& quads) {
+    for (const auto& plane : model.planes) {
+        if (plane.faces.empty()) continue;
+        const auto& faceData = plane.faces.begin()->second;
+        if (faceData.uv.size() != 4) continue;
+
+        float cz = (plane.from.z + plane.to.z) * 0.5f;
+        glm::vec3 quadVerts[4];
+        quadVerts[0] = glm::vec3(plane.from.x, plane.from.y, cz);
+        quadVerts[1] = glm::vec3(plane.to.x,   plane.from.y, cz);
+        quadVerts[2] = glm::vec3(plane.to.x,   plane.to.y,   cz);
+        quadVerts[3] = glm::vec3(plane.from.x, plane.to.y,   cz);
+
+        bool applyRotation = (plane.rotationAxis != '\0' && std::abs(plane.rotationAngle) > 1e-6f);
+        glm::mat4 rotMat(1.0f);
+        if (applyRotation) {
+            glm::vec3 axis(0.0f);
+            if (plane.rotationAxis == 'x') axis = glm::vec3(1.0f, 0.0f, 0.0f);
+            else if (plane.rotationAxis == 'y') axis = glm::vec3(0.0f, 1.0f, 0.0f);
+            else if (plane.rotationAxis == 'z') axis = glm::vec3(0.0f, 0.0f, 1.0f);
+            rotMat = glm::translate(glm::mat4(1.0f), plane.rotationOrigin) *
+                     glm::rotate(glm::mat4(1.0f), glm::radians(plane.rotationAngle), axis) *
+                     glm::translate(glm::mat4(1.0f), -plane.rotationOrigin);
+        }
+
+        for (int i = 0; i < 4; ++i) {
+            glm::vec3 pos = quadVerts[i];
+            if (applyRotation) {
+                glm::vec4 p = rotMat * glm::vec4(pos, 1.0f);
+                pos = glm::vec3(p.x, p.y, p.z);
+            }
+            if (plane.positionDirection != '\0' && std::abs(plane.positionOffset) > 1e-6f) {
+                if (plane.positionDirection == 'x') pos += glm::vec3(plane.positionOffset, 0.0f, 0.0f);
+                else if (plane.positionDirection == 'y') pos += glm::vec3(0.0f, plane.positionOffset, 0.0f);
+                else if (plane.positionDirection == 'z') pos += glm::vec3(0.0f, 0.0f, plane.positionOffset);
+            }
+            glm::vec2 uv(faceData.uv[i].first, faceData.uv[i].second);
+            quads.planeVertices.push_back(packChunkVertex(pos, info.textureCoords[0], uv, 0));
+        }
+    }
+}
+
+static void compileCuboids(const Model& model, const BlockDB::BlockInfo& info, BlockQuads& quads) {
+    static const char* faceNames[6] = {"north", "south", "west", "east", "up", "down"};
+    const float eps = 1e-6f;
+
+    for (int face = 0; face < 6; face++) {
+        for (size_t cuboidIndex = 0; cuboidIndex < model.cuboids.size(); cuboidIndex++) {
+            const auto& cuboid = model.cuboids[cuboidIndex];
+            auto it = cuboid.faces.find(faceNames[face]);
+            if (it == cuboid.faces.end()) continue;
+            const auto& faceData = it->second;
+            if (faceData.uv.size() != 4) continue;
+
+            glm::vec3 faceVerts[4];
+            getCuboidFaceVertices(face, cuboid.from, cuboid.to, faceVerts);
+
+            glm::vec2 atlasOffset = info.textureCoords[face];
+            if (cuboidIndex < info.multiTextureCoords.size())
+                atlasOffset = info.multiTextureCoords[cuboidIndex][face];
+
+            // Liquid top face and the upper corners of its sides wave, unless more liquid sits on top
+            float faceMaxY = std::max({faceVerts[0].y, faceVerts[1].y, faceVerts[2].y, faceVerts[3].y});
+            for (int i = 0; i < 4; ++i) {
+                bool isTop = info.liquid && (face == 4 || (face <= 3 && std::abs(faceVerts[i].y - faceMaxY) < eps));
+                glm::vec2 uv(faceData.uv[i].first, faceData.uv[i].second);
+                quads.faceVertices[face].push_back(packChunkVertex(faceVerts[i], atlasOffset, uv, face, isTop));
+            }
+        }
+    }
+}
+
+void BlockQuadDB::init() {
+    table.clear();
+
+    for (uint32_t id = 1; id <= UINT16_MAX; id++) {
+        const BlockDB::BlockInfo* info = BlockDB::getBlockInfo(static_cast<uint16_t>(id));
+        if (!info) continue;
+        const Model* model = ModelDB::getModel(info->modelName);
+
+        if (table.size() <= id)
+            table.resize(id + 1);
+        BlockQuads& quads = table[id];
+        if (!model || (model->cuboids.empty() && model->planes.empty()))
+            continue;
+
+        if (!model->planes.empty()) {
+            quads.type = BlockMeshType::Cross;
+            compilePlanes(*model, *info, quads);
+            continue;
+        }
+
+        compileCuboids(*model, *info, quads);
+        if (info->liquid) {
+            quads.type = BlockMeshType::Liquid;
+        } else if (BlockDB::hasFlags(id, BlockDB::FullCube) && !BlockDB::hasFlags(id, BlockDB::RenderFacesInBetween)) {
+            // Plain cubes go through the greedy mesher, everything else keeps one quad per face
+            quads.type = BlockMeshType::GreedyCube;
+            for (int face = 0; face < 6; face++) {
+                quads.atlasTiles[face] = info->multiTextureCoords.empty()
+                    ? info->textureCoords[face] : info->multiTextureCoords[0][face];
+            }
+        } else {
+            quads.type = BlockMeshType::Faces;
+        }
+    }
+
+    if (table.empty())
+        table.resize(1); // Air
+}
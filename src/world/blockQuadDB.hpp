@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "chunkVertex.hpp"
+
+// How a block ends up in the chunk mesh
+enum class BlockMeshType : uint8_t {
+    None,       // Air, unknown IDs and models without geometry
+    Cross,      // Planes, always drawn into the cross mesh
+    Liquid,     // Cuboid faces into the liquid mesh
+    GreedyCube, // Plain full cube, faces merged by the greedy mesher
+    Faces       // Cuboid faces into the opaque mesh, one quad each
+};
+
+// Every quad a block can emit, packed as block local ChunkVertex corners (4 per quad).
+// Meshing a block only adds the block position to the packed fields.
+struct BlockQuads {
+    BlockMeshType type = BlockMeshType::None;
+    std::vector<ChunkVertex> faceVertices[6]; // Cuboid quads by face direction: front, back, left, right, top, bottom
+    std::vector<ChunkVertex> planeVertices;   // Pre-rotated cross planes
+    glm::vec2 atlasTiles[6] = {};             // GreedyCube tile per face
+};
+
+// Quad templates for every block ID, compiled once from BlockDB and ModelDB.
+// Call init() after BlockDB::initProperties()
+class BlockQuadDB {
+public:
+    static void init();
+    static const BlockQuads& get(uint16_t type) {
+        return type < table.size() ? table[type] : table[0];
+    }
+    // One past the highest ID with templates
+    static size_t size() { return table.size(); }
+
+private:
+    static std::vector<BlockQuads> table;
+};
+
+// Corners of one face of the box from..to, in the order the model UVs are listed.
+// For the cube model U runs from out[0] to out[1] and V from out[0] to out[3]
+void getCuboidFaceVertices(int face, const glm::vec3& from, const glm::vec3& to, glm::vec3 out[4]);
+
+// Liquid top corners carry the wave flag, it is cleared when another liquid block sits on top
+constexpr uint32_t chunkVertexLiquidTopBit = 1u << 23;
@@ -3,7 +3,6 @@
 #include "../core/camera.hpp"
 #include "world.hpp"
 #include "blockDB.hpp"
-#include "modelDB.hpp"
 
 struct RaycastResult {
     bool hit = false;
@@ -18,18 +17,6 @@ struct RaycastResult {
 };
 
 
-// Helper function to get Hitbox for a block model
-bool getModelHitBoxes(uint8_t blockId, std::vector<std::pair<glm::vec3, glm::vec3>>& outBoxes) {
-    const BlockDB::BlockInfo* info = BlockDB::getBlockInfo(blockId);
-    if (!info) return false;
-
-    if (!ModelDB::getHitBoxes(info->modelName, outBoxes) || outBoxes.empty()) {
-        outBoxes.clear();
-        outBoxes.emplace_back(glm::vec3(0.0f), glm::vec3(1.0f));
-    }
-    return true;
-}
-
 // Ray-AABB intersection helper
 bool rayAABBIntersect(const glm::dvec3& rayOrigin, const glm::dvec3& rayDir, const glm::dvec3& boxMin, const glm::dvec3& boxMax, double& hitDist, double maxRayDist) {
     double nearestEntry = 0.0;
@@ -92,10 +79,9 @@ RaycastResult raycast(World* world, const glm::dvec3& origin, const glm::vec3& d
             if (localX >= 0 && localX < Chunk::chunkWidth &&
                 localY >= 0 && localY < Chunk::chunkHeight &&
                 localZ >= 0 && localZ < Chunk::chunkDepth) {
-                uint8_t type = chunk->blocks[localX][localY][localZ].type;
+                uint16_t type = chunk->getBlock(localX, localY, localZ);
                 if (type != 0) {
-                    std::vector<std::pair<glm::vec3, glm::vec3>> boxes;
-                    getModelHitBoxes(type, boxes);
+                    const auto& boxes = BlockDB::getHitBoxes(type);
 
                     double bestT = std::numeric_limits<double>::infinity();
                     glm::ivec3 nearestNormal(0);
@@ -161,35 +147,34 @@ RaycastResult raycast(World* world, const glm::dvec3& origin, const glm::vec3& d
     return result;
 }
 
-void placeBreakBlockOnClick(World* world, const Camera& camera, char action, uint8_t blockType) {
+void placeBreakBlockOnClick(World* world, const Camera& camera, char action, uint16_t blockType) {
     glm::dvec3 origin = camera.getPositionDouble();
     glm::vec3 dir = camera.getFront();
 
     RaycastResult hit = raycast(world, origin, dir, 6.0f);
 
-    int chunkX = 0, chunkZ = 0, x = 0, z = 0;
+    int chunkX = 0, chunkZ = 0, x = 0, y = 0, z = 0;
 
     // p = place, b = break
     if (action == 'b') {
         if (!hit.hit || !hit.hitChunk) return;
-        hit.hitChunk->blocks[hit.hitBlockPos.x][hit.hitBlockPos.y][hit.hitBlockPos.z].type = 0;
-        hit.hitChunk->buildMesh();
+        hit.hitChunk->setBlock(hit.hitBlockPos.x, hit.hitBlockPos.y, hit.hitBlockPos.z, 0);
+        hit.hitChunk->buildSectionMesh(hit.hitBlockPos.y);
 
         chunkX = hit.hitChunk->chunkX;
         chunkZ = hit.hitChunk->chunkZ;
         x = hit.hitBlockPos.x;
+        y = hit.hitBlockPos.y;
         z = hit.hitBlockPos.z;
     }
     else if (action == 'p') {
         if (!hit.hasPlacePos || !hit.placeChunk) return;
         // Prevent placement below bedrock or above chunk height
         if (hit.placeBlockPos.y < 0 || hit.placeBlockPos.y >= Chunk::chunkHeight) return;
-        auto& block = hit.placeChunk->blocks[hit.placeBlockPos.x][hit.placeBlockPos.y][hit.placeBlockPos.z];
-        if (block.type != 0) return;
+        if (hit.placeChunk->getBlock(hit.placeBlockPos.x, hit.placeBlockPos.y, hit.placeBlockPos.z) != 0) return;
 
         // Prevent placing inside player
-        std::vector<std::pair<glm::vec3, glm::vec3>> boxes;
-        getModelHitBoxes(blockType, boxes);
+        const auto& boxes = BlockDB::getHitBoxes(blockType);
 
         glm::dvec3 playerPos = camera.getPositionDouble();
         float playerRadius = camera.getPlayerRadius();
@@ -215,31 +200,32 @@ void placeBreakBlockOnClick(World* world, const Camera& camera, char action, uin
             if (overlap) return;
         }
 
-        block.type = blockType;
-        hit.placeChunk->buildMesh();
+        hit.placeChunk->setBlock(hit.placeBlockPos.x, hit.placeBlockPos.y, hit.placeBlockPos.z, blockType);
+        hit.placeChunk->buildSectionMesh(hit.placeBlockPos.y);
 
         chunkX = hit.placeChunk->chunkX;
         chunkZ = hit.placeChunk->chunkZ;
         x = hit.placeBlockPos.x;
+        y = hit.placeBlockPos.y;
         z = hit.placeBlockPos.z;
     }
 
-    // Rebuild neighbor chunk mesh if at chunk edge
+    // Rebuild the same sections of the neighbor chunk if at chunk edge
     if (x == 0) {
         Chunk* neighbor = world->getChunk(chunkX - 1, chunkZ);
-        if (neighbor) neighbor->buildMesh();
+        if (neighbor) neighbor->buildSectionMesh(y);
     }
     if (x == Chunk::chunkWidth - 1) {
         Chunk* neighbor = world->getChunk(chunkX + 1, chunkZ);
-        if (neighbor) neighbor->buildMesh();
+        if (neighbor) neighbor->buildSectionMesh(y);
     }
     if (z == 0) {
         Chunk* neighbor = world->getChunk(chunkX, chunkZ - 1);
-        if (neighbor) neighbor->buildMesh();
+        if (neighbor) neighbor->buildSectionMesh(y);
     }
     if (z == Chunk::chunkDepth - 1) {
         Chunk* neighbor = world->getChunk(chunkX, chunkZ + 1);
-        if (neighbor) neighbor->buildMesh();
+        if (neighbor) neighbor->buildSectionMesh(y);
     }
 }
 
@@ -247,7 +233,7 @@ void placeBreakBlockOnClick(World* world, const Camera& camera, char action, uin
 struct BlockInfo {
     bool valid = false;
     glm::ivec3 worldPos;
-    uint8_t type;
+    uint16_t type;
 };
 
 BlockInfo getLookedAtBlockInfo(World* world, const Camera& camera) {
@@ -264,7 +250,7 @@ BlockInfo getLookedAtBlockInfo(World* world, const Camera& camera) {
         hit.hitBlockPos.y,
         hit.hitChunk->chunkZ * Chunk::chunkDepth + hit.hitBlockPos.z
     );
-    info.type = hit.hitChunk->blocks[hit.hitBlockPos.x][hit.hitBlockPos.y][hit.hitBlockPos.z].type;
+    info.type = hit.hitChunk->getBlock(hit.hitBlockPos.x, hit.hitBlockPos.y, hit.hitBlockPos.z);
 
     return info;
 }
\ No newline at end of file
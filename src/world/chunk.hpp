@@ -3,52 +3,143 @@
 #include <vector>
 #include <glad/glad.h>
 #include "blockDB.hpp"
+#include "chunkSection.hpp"
+#include "sectionMeshBuffer.hpp"
+#include "crossMesh.hpp"
+#include "liquidFaceOrder.hpp"
+#include "sectionVisibility.hpp"
 #include "../core/camera.hpp"
 #include "world.hpp"
 #include "structureDB.hpp"
 #include "noise.hpp"
 
 class World;
+struct ChunkMeshSnapshot;
+struct ChunkMeshData;
 
 class Chunk {
 public:
     static const int chunkWidth = 16;
     static const int chunkHeight = 256;
     static const int chunkDepth = 16;
+    static const int sectionCount = chunkHeight / ChunkSection::sectionSize;
 
-    ChunkNoises noises;
-
-    struct Block {
-        uint8_t type;
+    // Occupancy summary of one 16x16x16 section, lets the mesher skip whole volumes
+    struct SectionSummary {
+        bool empty = true;   // Only air
+        bool opaque = false; // Only full opaque cubes
+        bool dirty = false;  // Edited since the last refreshSections()
     };
 
+    ChunkNoises noises;
+
     Chunk(int x, int z, World* worldPtr);
     ~Chunk();
 
+    // Clears the chunk for reuse at another position, call generateTerrain() afterwards
+    void reset(int x, int z);
+    // Hands the opaque, cross and liquid ranges back to World's arenas, for chunks going into the pool
+    void releaseMeshes();
+    // Fills in the blocks, safe to run off the main thread while the chunk is not in the world
+    void generateTerrain();
+    // Main thread, after the chunk was added to the world: applies structure blocks crossing chunk borders
+    void finishGeneration();
+
+    // Marks every section's mesh dirty, World rebuilds dirty chunks once per frame on a worker
     void buildMesh();
-    void render(const Camera& camera, GLint uModelLoc);
-    void renderCross(const Camera& camera, GLint uModelLoc);
-    void renderLiquid(const Camera& camera, GLint uLiquidModelLoc);
+    // Marks only the section holding block Y dirty, plus the adjacent one when Y is on a section boundary
+    void buildSectionMesh(int y);
+    // Copies what the mesher needs for the given sections, false when a neighbour chunk is missing
+    bool createMeshSnapshot(ChunkMeshSnapshot& snapshot, int firstSection, int lastSection);
+    // `mesher` and `ambient_occlusion` as the snapshots use them, read from the options once
+    static bool usesBinaryMesher();
+    static bool usesAmbientOcclusion();
+    // Applies the sections still current, returns how many were dropped as stale
+    int uploadMesh(const ChunkMeshData& mesh);
+    // Add the draws of the sections set in `sections` to World's pass wide multi-draw lists
+    void appendDraws(std::vector<GLsizei>& counts, std::vector<GLint>& baseVertices, uint16_t sections) const;
+    void appendCrossDraw(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, uint16_t sections) const;
+    // Appends the liquid faces to the frame's liquid index stream, back to front when `sortFaces` is set.
+    // True when they had to be re-sorted
+    bool appendLiquidDraw(const Camera& camera, uint16_t sections, bool sortFaces, std::vector<GLuint>& indices,
+                          std::vector<GLsizei>& counts, std::vector<const void*>& offsets, std::vector<GLint>& baseVertices);
+    bool hasLiquidDraw() const { return liquidAllocation.capacity != 0 && !liquidOrder.empty(); }
     void placeStructure(const Structure& structure, int baseX, int baseY, int baseZ);
 
-    Block blocks[chunkWidth][chunkHeight][chunkDepth];
+    // Coordinates are chunk local and must be in range
+    uint16_t getBlock(int x, int y, int z) const {
+        return sections[y >> 4].get(x, y & 15, z);
+    }
+    void setBlock(int x, int y, int z, uint16_t type) {
+        sections[y >> 4].set(x, y & 15, z, type);
+        sectionSummaries[y >> 4].dirty = true;
+        sectionsDirty = true;
+        sectionBlockVersions[y >> 4]++;
+        // Faces of the adjacent section depend on this layer too
+        if ((y & 15) == 0 && y > 0)
+            sectionBlockVersions[(y >> 4) - 1]++;
+        else if ((y & 15) == 15 && y < chunkHeight - 1)
+            sectionBlockVersions[(y >> 4) + 1]++;
+    }
+    // Compacts edited sections and brings their summaries up to date
+    void refreshSections();
+    const SectionSummary& getSectionSummary(int section) const { return sectionSummaries[section]; }
+    int getMinBlockY() const { return minBlockY; }
+    int getMaxBlockY() const { return maxBlockY; }
+    int getSkippedSectionCount() const;
+    // Face to face connectivity from the last uploaded mesh, see sectionVisibility.hpp. Sections not meshed yet
+    // count as open on every face
+    uint64_t getSectionConnectivity(int section) const { return sectionConnectivity[section]; }
+    size_t getOpaqueVertexCount() const { return opaqueMesh.getVertexCount(); }
+    size_t getCrossInstanceCount() const { return crossMesh.getInstanceCount(); }
+    // What the opaque mesh would hold with one quad per face, for the greedy meshing stats
+    size_t getUnmergedOpaqueVertexCount() const;
+    // Bit per section waiting for a rebuild in World's dirty list
+    uint16_t getDirtyMeshSections() const { return dirtyMeshSections; }
+    bool isMeshDirty() const { return dirtyMeshSections != 0; }
+    void addDirtyMeshSections(uint16_t sections) { dirtyMeshSections |= sections; }
+    uint16_t takeDirtyMeshSections() {
+        uint16_t sections = dirtyMeshSections;
+        dirtyMeshSections = 0;
+        return sections;
+    }
+    size_t getBlockMemoryUsage() const;
+
     int chunkX, chunkZ;
     int biomeIndex = 0;
 
 private:
     World* world;
+    ChunkSection sections[sectionCount];
+    SectionSummary sectionSummaries[sectionCount];
+    bool sectionsDirty = false;
+    int minBlockY = chunkHeight; // Lowest non-air Y, chunkHeight when empty
+    int maxBlockY = -1;          // Highest non-air Y, -1 when empty
+    bool sectionSkipped[sectionCount] = {}; // Sections the last uploaded mesh did not have to walk
+    size_t unmergedOpaqueVertices[sectionCount] = {};
+    uint64_t sectionConnectivity[sectionCount];
+    uint64_t sectionMeshRequests[sectionCount] = {}; // Latest World::takeMeshRequest() covering each section, other results are stale
+    uint64_t sectionBlockVersions[sectionCount] = {}; // Bumped by setBlock() in or next to the section
+    uint16_t dirtyMeshSections = 0;
 
-    GLuint VAO, VBO, EBO;
-    GLuint crossVAO, crossVBO, crossEBO;
-    GLuint liquidVAO, liquidVBO, liquidEBO;
-    GLsizei indexCount;
-    GLsizei crossIndexCount;
-    GLsizei liquidIndexCount;
+    SectionMeshBuffer opaqueMesh;
+    CrossMesh crossMesh;
+    MeshArena::Allocation liquidAllocation; // In World's liquid arena, indices are streamed per frame
 
-    std::vector<float> liquidVertexDataCPU;
+    // Liquid stays one range since it is re-sorted as a whole, rebuilt from these when a section changes
+    std::vector<ChunkVertex> liquidSectionVertices[sectionCount];
+    std::vector<unsigned int> liquidSectionIndices[sectionCount];
+    std::vector<ChunkVertex> liquidVertexDataCPU;
     std::vector<unsigned int> liquidIndexDataCPU;
+    LiquidFaceOrder liquidOrder; // Cached back to front order of liquidIndexDataCPU's faces
 
-    void addFace(std::vector<float>& vertices, std::vector<unsigned int>& indices, int x, int y, int z, int face, const BlockDB::BlockInfo* blockInfo, unsigned int& indexOffset);
+    void uploadLiquidMesh();
 
-    bool isBlockVisible(int x, int y, int z, int face) const;
+    // Structure blocks that landed in another chunk during generateTerrain()
+    struct SpilledBlock {
+        int chunkX, chunkZ;
+        int x, y, z;
+        uint16_t type;
+    };
+    std::vector<SpilledBlock> spilledBlocks;
 };
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <cstdlib>
+#include "chunkLoadQueue.hpp"
+
+void ChunkLoadQueue::push(int x, int z) {
+    float priority = priorityFunction ? priorityFunction(x, z) : 0.0f;
+
+    auto iterator = positions.find(packKey(x, z));
+    if (iterator != positions.end()) {
+        size_t index = iterator->second;
+        float oldPriority = heap[index].priority;
+        heap[index].priority = priority;
+        if (priority < oldPriority)
+            siftUp(index);
+        else
+            siftDown(index);
+        return;
+    }
+
+    heap.push_back({x, z, priority, Clock::now()});
+    positions[packKey(x, z)] = heap.size() - 1;
+    siftUp(heap.size() - 1);
+    stats.enqueued++;
+}
+
+bool ChunkLoadQueue::pop(Entry& entry) {
+    if (heap.empty())
+        return false;
+
+    if (prioritiesDirty) {
+        for (auto& queued : heap) {
+            queued.priority = priorityFunction ? priorityFunction(queued.x, queued.z) : 0.0f;
+        }
+        rebuildHeap();
+        prioritiesDirty = false;
+    }
+
+    entry = heap[0];
+    removeAt(0);
+
+    double waitMs = std::chrono::duration<double, std::milli>(Clock::now() - entry.enqueueTime).count();
+    totalWaitMs += waitMs;
+    poppedCount++;
+    stats.maxWaitMs = std::max(stats.maxWaitMs, waitMs);
+    return true;
+}
+
+void ChunkLoadQueue::cancelOutside(int centerX, int centerZ, int radius) {
+    size_t before = heap.size();
+    heap.erase(std::remove_if(heap.begin(), heap.end(), [&](const Entry& entry) {
+        if (std::abs(entry.x - centerX) <= radius && std::abs(entry.z - centerZ) <= radius)
+            return false;
+        positions.erase(packKey(entry.x, entry.z));
+        return true;
+    }), heap.end());
+    if (heap.size() == before)
+        return;
+    stats.cancelled += before - heap.size();
+    rebuildHeap();
+}
+
+ChunkLoadQueue::Stats ChunkLoadQueue::getStats() const {
+    Stats current = stats;
+    current.pending = heap.size();
+    current.averageWaitMs = poppedCount > 0 ? totalWaitMs / static_cast<double>(poppedCount) : 0.0;
+    return current;
+}
+
+void ChunkLoadQueue::rebuildHeap() {
+    // Every queued position is already indexed, only the heap indices change
+    for (size_t i = 0; i < heap.size(); i++) {
+        positions[keyAt(i)] = i;
+    }
+    for (size_t i = heap.size() / 2; i-- > 0;) {
+        siftDown(i);
+    }
+}
+
+void ChunkLoadQueue::removeAt(size_t index) {
+    positions.erase(keyAt(index));
+    size_t last = heap.size() - 1;
+    if (index != last) {
+        heap[index] = heap[last];
+        positions[keyAt(index)] = index;
+    }
+    heap.pop_back();
+
+    if (index < heap.size()) {
+        siftUp(index);
+        siftDown(index);
+    }
+}
+
+void ChunkLoadQueue::siftUp(size_t index) {
+    while (index > 0) {
+        size_t parent = (index - 1) / 2;
+        if (heap[parent].priority <= heap[index].priority)
+            break;
+        swapEntries(parent, index);
+        index = parent;
+    }
+}
+
+void ChunkLoadQueue::siftDown(size_t index) {
+    while (true) {
+        size_t left = index * 2 + 1;
+        size_t right = left + 1;
+        size_t best = index;
+        if (left < heap.size() && heap[left].priority < heap[best].priority)
+            best = left;
+        if (right < heap.size() && heap[right].priority < heap[best].priority)
+            best = right;
+        if (best == index)
+            return;
+        swapEntries(best, index);
+        index = best;
+    }
+}
+
+void ChunkLoadQueue::swapEntries(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    positions[keyAt(a)] = a;
+    positions[keyAt(b)] = b;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Chunk positions waiting to be generated, best priority (lowest value) first.
+// Entries are kept in a binary heap with a position index so they can be re-ranked in place. Priorities are recomputed lazily: invalidatePriorities() only marks
+// the heap stale and the next pop() re-ranks everything in one O(n) heapify.
+class ChunkLoadQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        int x, z;
+        float priority;
+        Clock::time_point enqueueTime;
+    };
+
+    struct Stats {
+        size_t pending = 0;
+        size_t enqueued = 0;
+        size_t cancelled = 0;
+        size_t completed = 0;
+        double averageWaitMs = 0.0; // Enqueue to pop, over every popped entry
+        double maxWaitMs = 0.0;
+    };
+
+    void setPriorityFunction(std::function<float(int, int)> function) { priorityFunction = std::move(function); }
+
+    // Adds the position, or re-ranks it in place if it is already queued
+    void push(int x, int z);
+    bool pop(Entry& entry);
+    bool contains(int x, int z) const { return positions.count(packKey(x, z)) != 0; }
+    // Cancels every entry farther than `radius` chunks (square distance) from the center
+    void cancelOutside(int centerX, int centerZ, int radius);
+
+    void invalidatePriorities() { prioritiesDirty = true; }
+
+    // Outcome of a popped entry, counted here so all load stats live in one place
+    void recordCompleted() { stats.completed++; }
+    void recordCancelled() { stats.cancelled++; }
+
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+    Stats getStats() const;
+
+private:
+    std::vector<Entry> heap;
+    std::unordered_map<uint64_t, size_t> positions; // Heap index of each queued position, by packKey()
+    std::function<float(int, int)> priorityFunction;
+    bool prioritiesDirty = false;
+
+    Stats stats;
+    double totalWaitMs = 0.0;
+    size_t poppedCount = 0;
+
+    static uint64_t packKey(int x, int z) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+    uint64_t keyAt(size_t index) const { return packKey(heap[index].x, heap[index].z); }
+
+    void rebuildHeap();
+    void removeAt(size_t index);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void swapEntries(size_t a, size_t b);
+};
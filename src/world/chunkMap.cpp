@@ -0,0 +1,228 @@
+#include <map>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include "chunkMap.hpp"
+
+static uint64_t packKey(int x, int z) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+}
+
+static uint64_t hashKey(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+}
+
+ChunkMap::ChunkMap() {
+    setWindowSize(16);
+}
+
+bool ChunkMap::insert(int x, int z, Chunk* chunk) {
+    if (find(x, z))
+        return false;
+
+    int32_t index = static_cast<int32_t>(entries.size());
+    entries.push_back({x, z, chunk});
+
+    int32_t& slot = grid[slotOf(x, z)];
+    if (slot < 0)
+        slot = index;
+    else
+        insertOverflow(packKey(x, z), index);
+    return true;
+}
+
+Chunk* ChunkMap::erase(int x, int z) {
+    int32_t index = -1;
+    int32_t& slot = grid[slotOf(x, z)];
+    if (slot >= 0 && entries[slot].x == x && entries[slot].z == z) {
+        index = slot;
+        slot = -1;
+    } else if (overflowCount > 0) {
+        uint64_t key = packKey(x, z);
+        int32_t* overflowIndex = findOverflowSlot(key);
+        if (overflowIndex) {
+            index = *overflowIndex;
+            eraseOverflow(key);
+        }
+    }
+    if (index < 0)
+        return nullptr;
+
+    Chunk* chunk = entries[index].chunk;
+
+    // Swap-remove to keep the entry array dense
+    int32_t last = static_cast<int32_t>(entries.size()) - 1;
+    if (index != last) {
+        entries[index] = entries[last];
+        setIndex(entries[index].x, entries[index].z, last, index);
+    }
+    entries.pop_back();
+    return chunk;
+}
+
+void ChunkMap::clear() {
+    entries.clear();
+    std::fill(grid.begin(), grid.end(), -1);
+    overflow.clear();
+    overflowCount = 0;
+}
+
+void ChunkMap::setWindowSize(int width) {
+    int size = 1;
+    int shift = 0;
+    while (size < width) {
+        size <<= 1;
+        shift++;
+    }
+    if (size - 1 == gridMask && !grid.empty())
+        return;
+
+    gridShift = shift;
+    gridMask = size - 1;
+    grid.assign(static_cast<size_t>(size) * size, -1);
+    overflow.clear();
+    overflowCount = 0;
+
+    for (int32_t i = 0; i < static_cast<int32_t>(entries.size()); i++) {
+        int32_t& slot = grid[slotOf(entries[i].x, entries[i].z)];
+        if (slot < 0)
+            slot = i;
+        else
+            insertOverflow(packKey(entries[i].x, entries[i].z), i);
+    }
+}
+
+void ChunkMap::setIndex(int x, int z, int32_t oldIndex, int32_t newIndex) {
+    int32_t& slot = grid[slotOf(x, z)];
+    if (slot == oldIndex) {
+        slot = newIndex;
+        return;
+    }
+    int32_t* overflowIndex = findOverflowSlot(packKey(x, z));
+    if (overflowIndex)
+        *overflowIndex = newIndex;
+}
+
+Chunk* ChunkMap::findOverflow(int x, int z) const {
+    uint64_t key = packKey(x, z);
+    size_t mask = overflow.size() - 1;
+    for (size_t i = hashKey(key) & mask; overflow[i].index >= 0; i = (i + 1) & mask) {
+        if (overflow[i].key == key)
+            return entries[overflow[i].index].chunk;
+    }
+    return nullptr;
+}
+
+int32_t* ChunkMap::findOverflowSlot(uint64_t key) {
+    if (overflow.empty())
+        return nullptr;
+    size_t mask = overflow.size() - 1;
+    for (size_t i = hashKey(key) & mask; overflow[i].index >= 0; i = (i + 1) & mask) {
+        if (overflow[i].key == key)
+            return &overflow[i].index;
+    }
+    return nullptr;
+}
+
+void ChunkMap::insertOverflow(uint64_t key, int32_t index) {
+    if ((overflowCount + 1) * 2 > overflow.size())
+        growOverflow();
+
+    size_t mask = overflow.size() - 1;
+    size_t i = hashKey(key) & mask;
+    while (overflow[i].index >= 0)
+        i = (i + 1) & mask;
+    overflow[i] = {key, index};
+    overflowCount++;
+}
+
+void ChunkMap::eraseOverflow(uint64_t key) {
+    size_t mask = overflow.size() - 1;
+    size_t i = hashKey(key) & mask;
+    while (overflow[i].index >= 0 && overflow[i].key != key)
+        i = (i + 1) & mask;
+    if (overflow[i].index < 0)
+        return;
+
+    overflow[i].index = -1;
+    overflowCount--;
+
+    // Backward shift deletion, pull later probes into the hole so lookups never stop early
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (overflow[j].index < 0)
+            break;
+        size_t home = hashKey(overflow[j].key) & mask;
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (stays)
+            continue;
+        overflow[i] = overflow[j];
+        overflow[j].index = -1;
+        i = j;
+    }
+}
+
+void ChunkMap::growOverflow() {
+    std::vector<OverflowSlot> old = std::move(overflow);
+    overflow.assign(std::max<size_t>(16, old.size() * 2), {0, -1});
+    overflowCount = 0;
+    for (const auto& slot : old) {
+        if (slot.index >= 0)
+            insertOverflow(slot.key, slot.index);
+    }
+}
+
+ChunkLookupBenchmark benchmarkChunkLookup(const ChunkMap& chunks, int lookups) {
+    ChunkLookupBenchmark result;
+    result.lookups = lookups;
+    if (chunks.empty() || lookups <= 0)
+        return result;
+
+    std::map<std::pair<int, int>, Chunk*> reference;
+    int minX = chunks[0].x, maxX = chunks[0].x;
+    int minZ = chunks[0].z, maxZ = chunks[0].z;
+    for (const auto& entry : chunks) {
+        reference[{entry.x, entry.z}] = entry.chunk;
+        minX = std::min(minX, entry.x);
+        maxX = std::max(maxX, entry.x);
+        minZ = std::min(minZ, entry.z);
+        maxZ = std::max(maxZ, entry.z);
+    }
+
+    // Include a ring of unloaded coordinates so misses are measured too
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> distX(minX - 2, maxX + 2);
+    std::uniform_int_distribution<int> distZ(minZ - 2, maxZ + 2);
+    std::vector<std::pair<int, int>> coords(lookups);
+    for (auto& coord : coords) {
+        coord = {distX(rng), distZ(rng)};
+    }
+
+    using clock = std::chrono::steady_clock;
+    uintptr_t mapSink = 0;
+    uintptr_t chunkMapSink = 0;
+
+    auto start = clock::now();
+    for (const auto& coord : coords) {
+        auto iterator = reference.find(coord);
+        mapSink += reinterpret_cast<uintptr_t>(iterator != reference.end() ? iterator->second : nullptr);
+    }
+    auto middle = clock::now();
+    for (const auto& coord : coords) {
+        chunkMapSink += reinterpret_cast<uintptr_t>(chunks.find(coord.first, coord.second));
+    }
+    auto end = clock::now();
+
+    // Both containers must agree, this also keeps the loops from being optimized away
+    result.matched = mapSink == chunkMapSink;
+
+    result.mapNanoseconds = std::chrono::duration<double, std::nano>(middle - start).count() / lookups;
+    result.chunkMapNanoseconds = std::chrono::duration<double, std::nano>(end - middle).count() / lookups;
+    return result;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Chunk;
+
+// Chunk lookup by chunk coordinates.
+// Loaded chunks live in a toroidal grid indexed by (x, z) modulo the window size, so
+// the common lookup is one masked array read. Chunks that collide with an occupied
+// slot (window smaller than the loaded area) go to an open-addressing hash instead.
+// All chunks are also kept in a dense array for iteration.
+class ChunkMap {
+public:
+    struct Entry {
+        int x, z;
+        Chunk* chunk;
+    };
+
+    ChunkMap();
+
+    Chunk* find(int x, int z) const {
+        int32_t index = grid[slotOf(x, z)];
+        if (index >= 0 && entries[index].x == x && entries[index].z == z)
+            return entries[index].chunk;
+        if (overflowCount == 0)
+            return nullptr;
+        return findOverflow(x, z);
+    }
+
+    bool insert(int x, int z, Chunk* chunk);
+    Chunk* erase(int x, int z);
+    void clear();
+
+    // Resizes the grid so a square of `width` chunks never collides
+    void setWindowSize(int width);
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const Entry& operator[](size_t index) const { return entries[index]; }
+    std::vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    std::vector<Entry>::const_iterator end() const { return entries.end(); }
+
+private:
+    int gridShift = 0;
+    int gridMask = 0;
+    std::vector<int32_t> grid; // Index into entries, -1 when empty
+    std::vector<Entry> entries;
+
+    struct OverflowSlot {
+        uint64_t key;
+        int32_t index; // -1 when empty
+    };
+    std::vector<OverflowSlot> overflow;
+    size_t overflowCount = 0;
+
+    size_t slotOf(int x, int z) const {
+        return static_cast<size_t>(x & gridMask) | (static_cast<size_t>(z & gridMask) << gridShift);
+    }
+
+    Chunk* findOverflow(int x, int z) const;
+    int32_t* findOverflowSlot(uint64_t key);
+    void insertOverflow(uint64_t key, int32_t index);
+    void eraseOverflow(uint64_t key);
+    void growOverflow();
+    void setIndex(int x, int z, int32_t oldIndex, int32_t newIndex);
+};
+
+struct ChunkLookupBenchmark {
+    int lookups = 0;
+    bool matched = false; // Both containers returned the same chunks
+    double mapNanoseconds = 0.0;   // Per lookup, std::map<std::pair<int, int>, Chunk*>
+    double chunkMapNanoseconds = 0.0; // Per lookup, ChunkMap
+};
+
+// Times random lookups around the loaded area against a std::map holding the same chunks
+ChunkLookupBenchmark benchmarkChunkLookup(const ChunkMap& chunks, int lookups);
@@ -0,0 +1,644 @@
+#include <algorithm>
+#include <memory>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "chunkMesher.hpp"
+#include "blockQuadDB.hpp"
+#include "modelDB.hpp"
+
+ChunkVertex* ChunkMeshBuffer::appendQuads(size_t quadCount) {
+    size_t firstVertex = vertices.size();
+    vertices.resize(firstVertex + quadCount * 4);
+    if (!indexed)
+        return vertices.data() + firstVertex;
+
+    size_t firstIndex = indices.size();
+    indices.resize(firstIndex + quadCount * 6);
+    unsigned int* index = indices.data() + firstIndex;
+    for (size_t quad = 0; quad < quadCount; quad++) {
+        unsigned int offset = indexOffset;
+        index[0] = offset;
+        index[1] = offset + 1;
+        index[2] = offset + 2;
+        index[3] = offset + 2;
+        index[4] = offset + 3;
+        index[5] = offset;
+        index += 6;
+        indexOffset += 4;
+    }
+    return vertices.data() + firstVertex;
+}
+
+void ChunkMeshData::reset() {
+    for (int i = 0; i < Chunk::sectionCount; i++) {
+        opaque[i].clear();
+        crossInstances[i].clear();
+        liquid[i].clear();
+        skipped[i] = false;
+        unmergedOpaqueVertices[i] = 0;
+        connectivity[i] = allFacesConnected;
+    }
+    buildMs = 0.0;
+    fromCache = false;
+}
+
+// True when the section has nothing to mesh: only air, or opaque cubes boxed in by opaque sections on all six sides
+static bool isSectionHidden(const ChunkMeshSnapshot& snapshot, int section) {
+    const Chunk::SectionSummary& summary = snapshot.summaries[section];
+    if (summary.empty)
+        return true;
+    if (!summary.opaque || section == 0 || section == Chunk::sectionCount - 1)
+        return false;
+    if (!snapshot.summaries[section - 1].opaque || !snapshot.summaries[section + 1].opaque)
+        return false;
+    for (int i = 0; i < 4; i++) {
+        if (!snapshot.neighborOpaque[i][section])
+            return false;
+    }
+    return true;
+}
+
+// Index offset to the neighbouring block for each face: front, back, left, right, top, bottom
+static const int faceOffsets[6] = {
+    PaddedChunkBlocks::strideZ, -PaddedChunkBlocks::strideZ,
+    -1, 1,
+    PaddedChunkBlocks::strideY, -PaddedChunkBlocks::strideY
+};
+
+void PaddedChunkBlocks::fill(const ChunkMeshSnapshot& snapshot) {
+    blocks.assign(static_cast<size_t>(sizeX) * sizeY * sizeZ, 0);
+
+    int firstSection = std::max(snapshot.firstSection - 1, 0);
+    int lastSection = std::min(snapshot.lastSection + 1, Chunk::sectionCount - 1);
+    for (int sectionIndex = firstSection; sectionIndex <= lastSection; sectionIndex++) {
+        const ChunkSection& section = snapshot.sections[sectionIndex];
+        bool uniform = section.isUniform();
+        uint16_t uniformType = section.getUniformType();
+        if (uniform && uniformType == 0)
+            continue;
+
+        for (int localY = 0; localY < ChunkSection::sectionSize; localY++) {
+            int y = sectionIndex * ChunkSection::sectionSize + localY;
+            for (int z = 0; z < Chunk::chunkDepth; z++) {
+                uint16_t* row = &blocks[indexOf(0, y, z)];
+                if (uniform) {
+                    std::fill(row, row + Chunk::chunkWidth, uniformType);
+                } else {
+                    for (int x = 0; x < Chunk::chunkWidth; x++) {
+                        row[x] = section.get(x, localY, z);
+                    }
+                }
+            }
+        }
+    }
+
+    int startY = std::max(snapshot.firstSection * ChunkSection::sectionSize - 1, 0);
+    int endY = std::min((snapshot.lastSection + 1) * ChunkSection::sectionSize, Chunk::chunkHeight - 1);
+    for (int y = startY; y <= endY; y++) {
+        for (int i = 0; i < Chunk::chunkWidth; i++) {
+            blocks[indexOf(i, y, Chunk::chunkDepth)] = snapshot.borders[0][y][i];
+            blocks[indexOf(i, y, -1)] = snapshot.borders[1][y][i];
+            blocks[indexOf(-1, y, i)] = snapshot.borders[2][y][i];
+            blocks[indexOf(Chunk::chunkWidth, y, i)] = snapshot.borders[3][y][i];
+        }
+    }
+}
+
+static bool isBlockVisible(const PaddedChunkBlocks& padded, int index, int face) {
+    // Out of height range lands in the air padding, so that counts as visible too
+    return BlockDB::isFaceVisible(padded.blocks[index], padded.blocks[index + faceOffsets[face]], face);
+}
+
+// Copies a block's quad templates into the buffer, moved to the block position.
+// Positions are packed in 1/32 block steps, so the offset is added straight to the packed x, y and z fields
+static void addQuads(const std::vector<ChunkVertex>& quads, ChunkMeshBuffer& buffer,
+                     int x, int y, int z, bool liquidAbove = false) {
+    if (quads.empty())
+        return;
+
+    const uint32_t step = static_cast<uint32_t>(ChunkVertexFormat::positionScale);
+    const uint32_t lowOffset = x * step + ((z * step) << 10);
+    const uint32_t highOffset = y * step;
+    const uint32_t lowMask = liquidAbove ? ~chunkVertexLiquidTopBit : ~0u;
+
+    ChunkVertex* out = buffer.appendQuads(quads.size() / 4);
+    for (const ChunkVertex& vertex : quads) {
+        *out++ = {(vertex.low + lowOffset) & lowMask, vertex.high + highOffset};
+    }
+}
+
+static void addCrossInstance(std::vector<uint32_t>& instances, int x, int y, int z, uint16_t type) {
+    instances.push_back(packCrossInstance(x, y, z, type));
+}
+
+// Visible cube faces of one section waiting to be merged, indexed [face][slice][row][column].
+// Slice runs along the face normal, rows and columns across the face
+struct GreedyFaces {
+    static const int size = ChunkSection::sectionSize;
+
+    std::vector<uint8_t> visible;
+    std::vector<glm::vec2> atlasOffsets;
+    std::vector<uint8_t> occlusion; // Ambient occlusion level per vertex, 2 bits each, see getFaceOcclusion()
+
+    GreedyFaces() : visible(6 * size * size * size, 0), atlasOffsets(6 * size * size * size),
+                    occlusion(6 * size * size * size, 0) {}
+
+    static int indexOf(int face, int slice, int row, int column) {
+        return ((face * size + slice) * size + row) * size + column;
+    }
+
+    // Section local block to slice/row/column for the given face
+    static int indexOfBlock(int face, int x, int y, int z) {
+        if (face <= 1) return indexOf(face, z, y, x);
+        if (face <= 3) return indexOf(face, x, y, z);
+        return indexOf(face, y, z, x);
+    }
+};
+
+// Padded index offsets of the two side blocks and the corner block that darken each vertex of a face,
+// relative to the block in front of the face. Vertices follow getCuboidFaceVertices()
+struct OcclusionOffsets {
+    int offsets[6][4][3];
+
+    OcclusionOffsets() {
+        const int strides[3] = {1, PaddedChunkBlocks::strideY, PaddedChunkBlocks::strideZ};
+        for (int face = 0; face < 6; face++) {
+            int normalAxis = face <= 1 ? 2 : (face <= 3 ? 0 : 1);
+            glm::vec3 corners[4];
+            getCuboidFaceVertices(face, glm::vec3(0.0f), glm::vec3(1.0f), corners);
+            for (int i = 0; i < 4; i++) {
+                int sides[2], side = 0;
+                for (int axis = 0; axis < 3; axis++) {
+                    if (axis == normalAxis) continue;
+                    sides[side++] = (corners[i][axis] > 0.5f ? 1 : -1) * strides[axis];
+                }
+                offsets[face][i][0] = sides[0];
+                offsets[face][i][1] = sides[1];
+                offsets[face][i][2] = sides[0] + sides[1];
+            }
+        }
+    }
+};
+
+// Classic three neighbour voxel AO: 0 when the vertex is open, 3 when both sides are blocked.
+// Packed as 2 bits per vertex
+static uint8_t getFaceOcclusion(const PaddedChunkBlocks& padded, int index, int face) {
+    static const OcclusionOffsets table;
+    int front = index + faceOffsets[face];
+    uint8_t packed = 0;
+    for (int i = 0; i < 4; i++) {
+        const int* offsets = table.offsets[face][i];
+        int side1 = BlockDB::hasFlags(padded.blocks[front + offsets[0]], BlockDB::Opaque);
+        int side2 = BlockDB::hasFlags(padded.blocks[front + offsets[1]], BlockDB::Opaque);
+        int corner = BlockDB::hasFlags(padded.blocks[front + offsets[2]], BlockDB::Opaque);
+        int level = side1 && side2 ? 3 : side1 + side2 + corner;
+        packed |= static_cast<uint8_t>(level << (i * 2));
+    }
+    return packed;
+}
+
+// Merges the collected faces into rectangles with the same texture. They are packed as tiled vertices, UVs count
+// whole tiles and the shader repeats the atlas tile across the quad
+static void addGreedyFaces(GreedyFaces& faces, ChunkMeshBuffer& buffer, int sectionY) {
+    static const Model* cube = ModelDB::getModel("cube");
+    static const char* faceNames[6] = {"north", "south", "west", "east", "up", "down"};
+    const int size = GreedyFaces::size;
+
+    for (int face = 0; face < 6; face++) {
+        auto faceIterator = cube->cuboids[0].faces.find(faceNames[face]);
+        if (faceIterator == cube->cuboids[0].faces.end() || faceIterator->second.uv.size() != 4)
+            continue;
+        const auto& faceUVs = faceIterator->second.uv;
+
+        for (int slice = 0; slice < size; slice++) {
+            for (int row = 0; row < size; row++) {
+                for (int column = 0; column < size; column++) {
+                    int start = GreedyFaces::indexOf(face, slice, row, column);
+                    if (!faces.visible[start]) continue;
+                    glm::vec2 atlasOffset = faces.atlasOffsets[start];
+                    uint8_t occlusion = faces.occlusion[start];
+                    // Only faces with the same AO on every corner merge, the shading would stretch otherwise
+                    bool mergeable = occlusion == (occlusion & 3) * 0x55;
+
+                    auto matches = [&](int index) {
+                        return faces.visible[index] && faces.atlasOffsets[index] == atlasOffset &&
+                               faces.occlusion[index] == occlusion;
+                    };
+
+                    int width = 1;
+                    while (mergeable && column + width < size && matches(start + width))
+                        width++;
+
+                    int height = 1;
+                    while (mergeable && row + height < size) {
+                        int rowStart = GreedyFaces::indexOf(face, slice, row + height, column);
+                        bool fullRow = true;
+                        for (int i = 0; i < width && fullRow; i++) {
+                            fullRow = matches(rowStart + i);
+                        }
+                        if (!fullRow) break;
+                        height++;
+                    }
+
+                    for (int h = 0; h < height; h++) {
+                        int rowStart = GreedyFaces::indexOf(face, slice, row + h, column);
+                        std::fill(faces.visible.begin() + rowStart, faces.visible.begin() + rowStart + width, 0);
+                    }
+
+                    glm::vec3 from, to;
+                    if (face <= 1) {
+                        from = glm::vec3(column, row, slice);
+                        to = glm::vec3(column + width, row + height, slice + 1);
+                    } else if (face <= 3) {
+                        from = glm::vec3(slice, row, column);
+                        to = glm::vec3(slice + 1, row + height, column + width);
+                    } else {
+                        from = glm::vec3(column, slice, row);
+                        to = glm::vec3(column + width, slice + 1, row + height);
+                    }
+                    from.y += sectionY;
+                    to.y += sectionY;
+
+                    int levels[4];
+                    for (int i = 0; i < 4; i++) {
+                        levels[i] = (occlusion >> (i * 2)) & 3;
+                    }
+                    // Quads split along vertex 0-2, start one vertex later to split along the less occluded diagonal
+                    int first = levels[0] + levels[2] > levels[1] + levels[3] ? 1 : 0;
+
+                    glm::vec3 faceVerts[4];
+                    getCuboidFaceVertices(face, from, to, faceVerts);
+                    ChunkVertex* out = buffer.appendQuads(1);
+                    for (int i = 0; i < 4; i++) {
+                        int vertex = (first + i) & 3;
+                        glm::vec2 uv(faceUVs[vertex].first * width, faceUVs[vertex].second * height);
+                        out[i] = packChunkVertex(faceVerts[vertex], atlasOffset, uv, face, false, true, levels[vertex]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Where the faces of the section being meshed end up
+struct SectionOutput {
+    ChunkMeshData& mesh;
+    GreedyFaces& greedyFaces;
+    int section;
+    int sectionY;
+    bool ambientOcclusion;
+    size_t greedyFaceCount = 0;
+};
+
+// Adds one visible face of a block to the mesh its type belongs in
+static void addVisibleFace(SectionOutput& out, const PaddedChunkBlocks& padded, const BlockQuads& quads,
+                           int index, int x, int y, int z, int face) {
+    switch (quads.type) {
+        case BlockMeshType::Liquid: {
+            // Air padding above the top layer
+            bool liquidAbove = BlockDB::hasFlags(padded.blocks[index + PaddedChunkBlocks::strideY], BlockDB::Liquid);
+            addQuads(quads.faceVertices[face], out.mesh.liquid[out.section], x, y, z, liquidAbove);
+            break;
+        }
+        case BlockMeshType::GreedyCube: {
+            int cell = GreedyFaces::indexOfBlock(face, x, y - out.sectionY, z);
+            out.greedyFaces.visible[cell] = 1;
+            out.greedyFaces.atlasOffsets[cell] = quads.atlasTiles[face];
+            out.greedyFaces.occlusion[cell] = out.ambientOcclusion ? getFaceOcclusion(padded, index, face) : 0;
+            out.greedyFaceCount++;
+            break;
+        }
+        case BlockMeshType::Faces:
+            addQuads(quads.faceVertices[face], out.mesh.opaque[out.section], x, y, z);
+            break;
+        default:
+            break;
+    }
+}
+
+// Per-face mesher: tests every face of every block against its neighbour
+static void addSectionBlocks(SectionOutput& out, const ChunkMeshSnapshot& snapshot, const PaddedChunkBlocks& padded) {
+    int startY = std::max(out.sectionY, snapshot.minBlockY);
+    int endY = std::min(out.sectionY + ChunkSection::sectionSize - 1, snapshot.maxBlockY);
+
+    for (int x = 0; x < Chunk::chunkWidth; x++) {
+        for (int y = startY; y <= endY; y++) {
+            for (int z = 0; z < Chunk::chunkDepth; z++) {
+                int index = PaddedChunkBlocks::indexOf(x, y, z);
+                uint16_t type = padded.blocks[index];
+                if (type == 0) continue;
+
+                const BlockQuads& quads = BlockQuadDB::get(type);
+                if (quads.type == BlockMeshType::Cross) {
+                    addCrossInstance(out.mesh.crossInstances[out.section], x, y, z, type);
+                    continue;
+                }
+                if (quads.type == BlockMeshType::None)
+                    continue;
+
+                for (int face = 0; face < 6; face++) {
+                    if (isBlockVisible(padded, index, face))
+                        addVisibleFace(out, padded, quads, index, x, y, z, face);
+                }
+            }
+        }
+    }
+}
+
+static int lowestSetBit(uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// Binary mesher: each column of the chunk and its border is a few 64-bit masks with one bit per block
+// along Y, so the visible faces of 64 blocks come out of a handful of shifts and ANDs against the
+// neighbouring columns. Follows the same rules as the BlockDB face visibility matrix
+struct ColumnMasks {
+    static_assert(Chunk::chunkWidth == Chunk::chunkDepth, "Columns are indexed as a square");
+    static_assert(Chunk::chunkHeight % 64 == 0, "Column height must be whole words");
+    static const int words = Chunk::chunkHeight / 64;
+    static const int size = Chunk::chunkWidth + 2; // Chunk plus the border columns
+
+    // Block categories, indexed by column(x, z)
+    std::vector<uint64_t> culling;     // Cube or liquid models, hide touching faces of the same kind
+    std::vector<uint64_t> liquid;
+    std::vector<uint64_t> transparent;
+    std::vector<uint64_t> keepsFaces;  // renderFacesInBetween while faster_trees is off
+    std::vector<uint64_t> faceBlocks;  // Blocks meshed face by face (opaque, liquid and greedy cubes)
+    std::vector<uint64_t> planeBlocks; // Cross blocks, never culled
+    // Visible faces of the chunk's own blocks, indexed by visibleIndex(face, x, z)
+    std::vector<uint64_t> visible;
+
+    ColumnMasks() :
+        culling(size * size * words, 0), liquid(size * size * words, 0), transparent(size * size * words, 0),
+        keepsFaces(size * size * words, 0), faceBlocks(size * size * words, 0), planeBlocks(size * size * words, 0),
+        visible(6 * Chunk::chunkWidth * Chunk::chunkDepth * words, 0) {}
+
+    // Chunk local x/z, -1 and chunkWidth address the border
+    static int column(int x, int z) {
+        return ((z + 1) * size + (x + 1)) * words;
+    }
+    static int visibleIndex(int face, int x, int z) {
+        return ((face * Chunk::chunkDepth + z) * Chunk::chunkWidth + x) * words;
+    }
+
+    void build(const ChunkMeshSnapshot& snapshot, const PaddedChunkBlocks& padded) {
+        for (auto* masks : {&culling, &liquid, &transparent, &keepsFaces, &faceBlocks, &planeBlocks}) {
+            std::fill(masks->begin(), masks->end(), 0);
+        }
+
+        // Only blocks inside the snapshot range or touching it, and no further than the chunk's own blocks reach
+        int startY = std::max({snapshot.firstSection * ChunkSection::sectionSize - 1, snapshot.minBlockY, 0});
+        int endY = std::min({(snapshot.lastSection + 1) * ChunkSection::sectionSize, snapshot.maxBlockY, Chunk::chunkHeight - 1});
+
+        for (int z = -1; z <= Chunk::chunkDepth; z++) {
+            for (int x = -1; x <= Chunk::chunkWidth; x++) {
+                int columnIndex = column(x, z);
+                for (int y = startY; y <= endY; y++) {
+                    uint16_t type = padded.get(x, y, z);
+                    if (type == 0) continue;
+
+                    int word = columnIndex + (y >> 6);
+                    uint64_t bit = 1ull << (y & 63);
+                    uint16_t flags = BlockDB::getFlags(type);
+                    if (flags & BlockDB::CullingShape) culling[word] |= bit;
+                    if (flags & BlockDB::Liquid) liquid[word] |= bit;
+                    if (flags & BlockDB::Transparent) transparent[word] |= bit;
+                    if (flags & BlockDB::KeepsInnerFaces) keepsFaces[word] |= bit;
+
+                    BlockMeshType meshType = BlockQuadDB::get(type).type;
+                    if (meshType == BlockMeshType::Cross) planeBlocks[word] |= bit;
+                    else if (meshType != BlockMeshType::None) faceBlocks[word] |= bit;
+                }
+            }
+        }
+
+        int firstWord = (snapshot.firstSection * ChunkSection::sectionSize) >> 6;
+        int lastWord = ((snapshot.lastSection + 1) * ChunkSection::sectionSize - 1) >> 6;
+        for (int z = 0; z < Chunk::chunkDepth; z++) {
+            for (int x = 0; x < Chunk::chunkWidth; x++) {
+                int self = column(x, z);
+                for (int word = firstWord; word <= lastWord; word++) {
+                    uint64_t blocks = faceBlocks[self + word];
+                    uint64_t thisLiquid = liquid[self + word];
+                    uint64_t thisTransparent = transparent[self + word];
+                    uint64_t canHide = culling[self + word] & ~keepsFaces[self + word];
+
+                    for (int face = 0; face < 6; face++) {
+                        uint64_t neighborCulling = neighbor(culling, face, x, z, word);
+                        uint64_t neighborLiquid = neighbor(liquid, face, x, z, word);
+                        uint64_t neighborTransparent = neighbor(transparent, face, x, z, word);
+
+                        uint64_t hidden = canHide & neighborCulling &
+                                          ~(neighborLiquid & ~thisLiquid) &
+                                          ~(neighborTransparent & ~thisTransparent);
+                        if (face == 4) // Liquid surfaces show from above unless more liquid sits on top
+                            hidden &= ~(thisLiquid & ~neighborLiquid);
+                        visible[visibleIndex(face, x, z) + word] = blocks & ~hidden;
+                    }
+                }
+            }
+        }
+    }
+
+    // Masks of the neighbouring blocks on `face`, lined up with the bits of column (x, z)
+    static uint64_t neighbor(const std::vector<uint64_t>& masks, int face, int x, int z, int word) {
+        static const int columnOffsets[4][2] = {{0, 1}, {0, -1}, {-1, 0}, {1, 0}};
+        if (face < 4)
+            return masks[column(x + columnOffsets[face][0], z + columnOffsets[face][1]) + word];
+
+        const uint64_t* columnWords = &masks[column(x, z)];
+        if (face == 4) // Block above, bit 63 takes bit 0 of the next word
+            return (columnWords[word] >> 1) | (word + 1 < words ? columnWords[word + 1] << 63 : 0);
+        return (columnWords[word] << 1) | (word > 0 ? columnWords[word - 1] >> 63 : 0);
+    }
+};
+
+static void addSectionBlocksBinary(SectionOutput& out, const ColumnMasks& masks, const PaddedChunkBlocks& padded) {
+    int word = out.sectionY >> 6;
+    int shift = out.sectionY & 63;
+    const uint64_t sectionMask = (1ull << ChunkSection::sectionSize) - 1;
+
+    for (int x = 0; x < Chunk::chunkWidth; x++) {
+        for (int z = 0; z < Chunk::chunkDepth; z++) {
+            uint64_t planeBits = (masks.planeBlocks[ColumnMasks::column(x, z) + word] >> shift) & sectionMask;
+            while (planeBits) {
+                int y = out.sectionY + lowestSetBit(planeBits);
+                planeBits &= planeBits - 1;
+                addCrossInstance(out.mesh.crossInstances[out.section], x, y, z, padded.get(x, y, z));
+            }
+
+            for (int face = 0; face < 6; face++) {
+                uint64_t faceBits = (masks.visible[ColumnMasks::visibleIndex(face, x, z) + word] >> shift) & sectionMask;
+                while (faceBits) {
+                    int y = out.sectionY + lowestSetBit(faceBits);
+                    faceBits &= faceBits - 1;
+                    int index = PaddedChunkBlocks::indexOf(x, y, z);
+                    addVisibleFace(out, padded, BlockQuadDB::get(padded.blocks[index]), index, x, y, z, face);
+                }
+            }
+        }
+    }
+}
+
+// Flood fill scratch for getSectionConnectivity(), one bit per section block
+struct ConnectivityFill {
+    static const int size = ChunkSection::sectionSize;
+
+    std::vector<uint64_t> visited;
+    std::vector<uint16_t> stack; // Section local x | z << 4 | y << 8
+
+    ConnectivityFill() : visited(size * size * size / 64) {
+        stack.reserve(size * size * size);
+    }
+};
+
+// Section face bits a block touches, same order as faceOffsets
+static uint8_t getBoundaryFaces(int x, int y, int z) {
+    const int last = ChunkSection::sectionSize - 1;
+    return (z == last ? 1 : 0) | (z == 0 ? 2 : 0) | (x == 0 ? 4 : 0) | (x == last ? 8 : 0) |
+           (y == last ? 16 : 0) | (y == 0 ? 32 : 0);
+}
+
+// Flood fills the non-opaque blocks of one section and links every pair of faces the same open
+// region touches, see getFaceConnectionBit()
+static uint64_t getSectionConnectivity(ConnectivityFill& fill, const PaddedChunkBlocks& padded, int sectionY) {
+    const int size = ConnectivityFill::size;
+    std::fill(fill.visited.begin(), fill.visited.end(), 0);
+    auto isOpen = [&](int local) {
+        int x = local & 15, z = (local >> 4) & 15, y = local >> 8;
+        return !BlockDB::hasFlags(padded.get(x, sectionY + y, z), BlockDB::Opaque);
+    };
+    auto visit = [&](int local) {
+        uint64_t bit = 1ull << (local & 63);
+        if (fill.visited[local >> 6] & bit)
+            return false;
+        fill.visited[local >> 6] |= bit;
+        return true;
+    };
+
+    uint64_t connectivity = 0;
+    for (int start = 0; start < size * size * size; start++) {
+        // Only regions reaching the section's surface can link faces, so fills start there
+        int startX = start & 15, startZ = (start >> 4) & 15, startY = start >> 8;
+        if (getBoundaryFaces(startX, startY, startZ) == 0 || !isOpen(start) || !visit(start))
+            continue;
+
+        uint8_t faces = 0;
+        fill.stack.clear();
+        fill.stack.push_back(static_cast<uint16_t>(start));
+        while (!fill.stack.empty()) {
+            int local = fill.stack.back();
+            fill.stack.pop_back();
+            int x = local & 15, z = (local >> 4) & 15, y = local >> 8;
+            uint8_t boundary = getBoundaryFaces(x, y, z);
+            faces |= boundary;
+
+            const int steps[6] = {16, -16, -1, 1, 256, -256};
+            for (int face = 0; face < 6; face++) {
+                if (boundary & (1 << face))
+                    continue;
+                int next = local + steps[face];
+                if (isOpen(next) && visit(next))
+                    fill.stack.push_back(static_cast<uint16_t>(next));
+            }
+        }
+
+        for (int from = 0; from < 6; from++) {
+            if (!(faces & (1 << from)))
+                continue;
+            for (int to = 0; to < 6; to++) {
+                if (faces & (1 << to))
+                    connectivity |= getFaceConnectionBit(from, to);
+            }
+        }
+        if (connectivity == allFacesConnected)
+            break;
+    }
+    return connectivity;
+}
+
+// Per-thread meshing arena, reused by every rebuild on its thread
+struct MeshScratch {
+    PaddedChunkBlocks padded;
+    GreedyFaces greedyFaces;
+    ConnectivityFill connectivityFill;
+    std::unique_ptr<ColumnMasks> columnMasks; // Made on first use of the binary mesher
+
+    // Largest vertex/index count each section reached on this thread, per opaque/liquid buffer, and
+    // the largest cross instance count. Buffers are reserved up front with these so they grow once
+    // instead of doubling their way up
+    size_t vertexHints[2][Chunk::sectionCount] = {};
+    size_t indexHints[2][Chunk::sectionCount] = {};
+    size_t crossInstanceHints[Chunk::sectionCount] = {};
+
+    MeshScratch() {
+        padded.blocks.reserve(static_cast<size_t>(PaddedChunkBlocks::sizeX) * PaddedChunkBlocks::sizeY * PaddedChunkBlocks::sizeZ);
+    }
+};
+
+void prepareChunkMesh(const ChunkMeshSnapshot& snapshot, ChunkMeshData& mesh) {
+    mesh.reset();
+    mesh.chunkX = snapshot.chunkX;
+    mesh.chunkZ = snapshot.chunkZ;
+    mesh.meshRequest = snapshot.meshRequest;
+    mesh.firstSection = snapshot.firstSection;
+    mesh.lastSection = snapshot.lastSection;
+    std::copy(std::begin(snapshot.sectionBlockVersions), std::end(snapshot.sectionBlockVersions), mesh.sectionBlockVersions);
+}
+
+void buildChunkMesh(const ChunkMeshSnapshot& snapshot, ChunkMeshData& mesh) {
+    static thread_local MeshScratch scratch;
+
+    prepareChunkMesh(snapshot, mesh);
+
+    PaddedChunkBlocks& padded = scratch.padded;
+    padded.fill(snapshot);
+
+    ColumnMasks* columnMasks = nullptr;
+    if (snapshot.mesher == ChunkMesherType::Binary) {
+        if (!scratch.columnMasks)
+            scratch.columnMasks = std::make_unique<ColumnMasks>();
+        columnMasks = scratch.columnMasks.get();
+        columnMasks->build(snapshot, padded);
+    }
+
+    for (int section = snapshot.firstSection; section <= snapshot.lastSection; section++) {
+        ChunkMeshBuffer* buffers[2] = {&mesh.opaque[section], &mesh.liquid[section]};
+        if (isSectionHidden(snapshot, section)) {
+            mesh.skipped[section] = true;
+            // Air is open everywhere, buried stone nowhere
+            mesh.connectivity[section] = snapshot.summaries[section].empty ? allFacesConnected : 0;
+            continue;
+        }
+        mesh.connectivity[section] = getSectionConnectivity(scratch.connectivityFill, padded, section * ChunkSection::sectionSize);
+
+        for (int i = 0; i < 2; i++) {
+            reserveFromHint(buffers[i]->vertices, scratch.vertexHints[i][section]);
+            reserveFromHint(buffers[i]->indices, scratch.indexHints[i][section]);
+        }
+        reserveFromHint(mesh.crossInstances[section], scratch.crossInstanceHints[section]);
+
+        SectionOutput out{mesh, scratch.greedyFaces, section, section * ChunkSection::sectionSize, snapshot.ambientOcclusion};
+        if (columnMasks)
+            addSectionBlocksBinary(out, *columnMasks, padded);
+        else
+            addSectionBlocks(out, snapshot, padded);
+
+        size_t perFaceVertices = mesh.opaque[section].vertices.size();
+        addGreedyFaces(scratch.greedyFaces, mesh.opaque[section], out.sectionY);
+        mesh.unmergedOpaqueVertices[section] = perFaceVertices + out.greedyFaceCount * 4;
+
+        for (int i = 0; i < 2; i++) {
+            scratch.vertexHints[i][section] = std::max(scratch.vertexHints[i][section], buffers[i]->vertices.size());
+            scratch.indexHints[i][section] = std::max(scratch.indexHints[i][section], buffers[i]->indices.size());
+        }
+        scratch.crossInstanceHints[section] = std::max(scratch.crossInstanceHints[section], mesh.crossInstances[section].size());
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "chunk.hpp"
+#include "chunkVertex.hpp"
+
+// Mesher implementation, picked with the `mesher` option
+enum class ChunkMesherType : uint8_t {
+    PerFace = 0, // Tests each face of each block
+    Binary = 1   // 64-bit column masks, culls 64 blocks at a time
+};
+
+// Everything the mesher reads, copied on the main thread so meshing can run on a worker
+// while the chunk keeps being edited. Sections stay palette compressed here, the worker
+// expands them into PaddedChunkBlocks.
+struct ChunkMeshSnapshot {
+    int chunkX, chunkZ;
+    uint64_t meshRequest; // World::takeMeshRequest() when the snapshot was taken
+    int firstSection, lastSection; // Sections to rebuild, only these and the ones touching them are copied
+    uint64_t sectionBlockVersions[Chunk::sectionCount]; // Chunk block versions when the snapshot was taken
+
+    ChunkSection sections[Chunk::sectionCount];
+    Chunk::SectionSummary summaries[Chunk::sectionCount];
+    bool neighborOpaque[4][Chunk::sectionCount]; // Neighbour section summaries, only `opaque` is needed
+    int minBlockY, maxBlockY;
+    ChunkMesherType mesher;
+    bool ambientOcclusion; // Bake per-vertex AO into greedy cube faces, `ambient_occlusion` option
+
+    // Neighbour blocks touching this chunk, [neighbour][y][x or z along the shared edge]
+    // Order follows Chunk::buildMesh(): front (z+1), back (z-1), left (x-1), right (x+1)
+    uint16_t borders[4][Chunk::chunkHeight][Chunk::chunkWidth];
+};
+
+// Chunk blocks plus a one block border on every side: neighbour columns on X/Z and air above
+// and below. Built once per rebuild so neighbour lookups are plain index offsets.
+struct PaddedChunkBlocks {
+    static const int sizeX = Chunk::chunkWidth + 2;
+    static const int sizeY = Chunk::chunkHeight + 2;
+    static const int sizeZ = Chunk::chunkDepth + 2;
+    static const int strideZ = sizeX;
+    static const int strideY = sizeX * sizeZ;
+
+    std::vector<uint16_t> blocks;
+
+    // Chunk local coordinates, -1 and chunkWidth/chunkHeight/chunkDepth address the border
+    static int indexOf(int x, int y, int z) {
+        return ((y + 1) * sizeZ + (z + 1)) * sizeX + (x + 1);
+    }
+    uint16_t get(int x, int y, int z) const { return blocks[indexOf(x, y, z)]; }
+
+    // Fills the snapshot's section range plus one layer above and below, the rest stays air.
+    // Diagonal border columns are left as air, so ambient occlusion treats those corners as open
+    void fill(const ChunkMeshSnapshot& snapshot);
+};
+
+struct ChunkMeshBuffer {
+    std::vector<ChunkVertex> vertices;
+    std::vector<unsigned int> indices; // Only filled when indexed
+    unsigned int indexOffset = 0;
+    // Liquid keeps its own indices so they can be sorted, opaque quads are drawn
+    // with SectionMeshBuffer's shared quad index buffer
+    bool indexed = false;
+
+    // Grows the buffer by `quadCount` quads, indices included when indexed. The caller writes
+    // the 4 vertices per quad through the returned pointer
+    ChunkVertex* appendQuads(size_t quadCount);
+    void clear() {
+        vertices.clear();
+        indices.clear();
+        indexOffset = 0;
+    }
+
+    size_t getByteSize() const {
+        return vertices.size() * sizeof(ChunkVertex) + indices.size() * sizeof(unsigned int);
+    }
+};
+
+// CPU side result of meshing a range of sections, uploaded later by Chunk::uploadMesh().
+// Every section has its own buffers with section local indices.
+struct ChunkMeshData {
+    int chunkX, chunkZ;
+    uint64_t meshRequest;
+    int firstSection, lastSection;
+    uint64_t sectionBlockVersions[Chunk::sectionCount];
+
+    ChunkMeshBuffer opaque[Chunk::sectionCount];
+    std::vector<uint32_t> crossInstances[Chunk::sectionCount]; // packCrossInstance() records
+    ChunkMeshBuffer liquid[Chunk::sectionCount];
+    bool skipped[Chunk::sectionCount] = {};
+    size_t unmergedOpaqueVertices[Chunk::sectionCount] = {}; // Opaque vertex count without greedy merging
+    uint64_t connectivity[Chunk::sectionCount]; // Face to face links for cave culling, set by reset()
+    double buildMs = 0.0;   // Worker time spent in buildChunkMesh(), or copying from the mesh cache on a hit
+    bool fromCache = false; // Copied from the mesh cache instead of meshed
+
+    ChunkMeshData() {
+        for (auto& buffer : liquid) {
+            buffer.indexed = true;
+        }
+        std::fill(std::begin(connectivity), std::end(connectivity), allFacesConnected);
+    }
+
+    // Empties every section for the next build, buffers keep their capacity
+    void reset();
+
+    size_t getByteSize() const {
+        size_t size = 0;
+        for (int i = firstSection; i <= lastSection; i++) {
+            size += opaque[i].getByteSize() + crossInstances[i].size() * sizeof(uint32_t) + liquid[i].getByteSize();
+        }
+        return size;
+    }
+};
+
+// Snapshot and result of one rebuild. World recycles these, so a rebuild reuses the section copies
+// and mesh buffers of an earlier one instead of allocating new ones
+struct ChunkMeshJob {
+    ChunkMeshSnapshot snapshot;
+    ChunkMeshData mesh;
+};
+
+// Resets the mesh and copies the request fields (position, range, versions) over from the snapshot
+void prepareChunkMesh(const ChunkMeshSnapshot& snapshot, ChunkMeshData& mesh);
+
+// Thread safe, only reads the snapshot and the block/model databases.
+// Scratch space lives in a per-thread arena that is reused by every build on that thread
+void buildChunkMesh(const ChunkMeshSnapshot& snapshot, ChunkMeshData& mesh);
+
+// Buffers are reserved up front with the largest size seen so far (`hint`), so they grow once instead
+// of doubling their way up and stay allocation free once warmed up
+template <typename T>
+void reserveFromHint(std::vector<T>& buffer, size_t hint) {
+    if (buffer.capacity() < hint)
+        buffer.reserve(hint);
+}
+
+// Copy assignment that raises `hint` to the copied size and reserves from it first
+template <typename T>
+void assignFromHint(std::vector<T>& buffer, const std::vector<T>& values, size_t& hint) {
+    hint = std::max(hint, values.size());
+    reserveFromHint(buffer, hint);
+    buffer.assign(values.begin(), values.end());
+}
@@ -0,0 +1,57 @@
+#include "chunkPool.hpp"
+#include "chunk.hpp"
+
+ChunkPool::ChunkPool(World* worldPtr, size_t capacity) : world(worldPtr), capacity(capacity) {
+    freeChunks.reserve(capacity);
+}
+
+ChunkPool::~ChunkPool() {
+    for (Chunk* chunk : freeChunks) {
+        delete chunk;
+    }
+    freeChunks.clear();
+}
+
+Chunk* ChunkPool::acquire(int x, int z) {
+    if (freeChunks.empty()) {
+        stats.misses++;
+        return new Chunk(x, z, world);
+    }
+
+    stats.hits++;
+    Chunk* chunk = freeChunks.back();
+    freeChunks.pop_back();
+    chunk->reset(x, z);
+    return chunk;
+}
+
+void ChunkPool::release(Chunk* chunk) {
+    if (!chunk)
+        return;
+
+    stats.releases++;
+    // A pooled chunk is never drawn, its arena pages can go to the chunks that are
+    chunk->releaseMeshes();
+    if (freeChunks.size() >= capacity) {
+        stats.evictions++;
+        delete chunk;
+        return;
+    }
+    freeChunks.push_back(chunk);
+}
+
+void ChunkPool::setCapacity(size_t newCapacity) {
+    capacity = newCapacity;
+    while (freeChunks.size() > capacity) {
+        delete freeChunks.back();
+        freeChunks.pop_back();
+        stats.evictions++;
+    }
+}
+
+ChunkPool::Stats ChunkPool::getStats() const {
+    Stats current = stats;
+    current.pooled = freeChunks.size();
+    current.capacity = capacity;
+    return current;
+}
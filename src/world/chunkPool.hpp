@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class Chunk;
+class World;
+
+// Keeps unloaded chunks around so their block storage and CPU side mesh buffers can be reused
+// for the next chunk that loads instead of being deleted and allocated again. Their ranges in
+// World's mesh arenas are released as they come in, see Chunk::releaseMeshes().
+class ChunkPool {
+public:
+    struct Stats {
+        size_t hits = 0;      // acquire() served from the pool
+        size_t misses = 0;    // acquire() had to allocate a new chunk
+        size_t releases = 0;  // Chunks handed back to the pool
+        size_t evictions = 0; // Releases deleted because the pool was full
+        size_t pooled = 0;    // Chunks currently waiting for reuse
+        size_t capacity = 0;
+    };
+
+    ChunkPool(World* worldPtr, size_t capacity);
+    ~ChunkPool();
+
+    // Returns a blank chunk at (x, z) ready for generateTerrain(), recycled when possible
+    Chunk* acquire(int x, int z);
+    void release(Chunk* chunk);
+
+    void setCapacity(size_t newCapacity);
+    Stats getStats() const;
+
+private:
+    World* world;
+    size_t capacity;
+    std::vector<Chunk*> freeChunks;
+    Stats stats;
+};
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include "chunkSection.hpp"
+
+static uint8_t bitsForPaletteSize(size_t paletteSize) {
+    uint8_t bits = 1;
+    while ((1ull << bits) < paletteSize)
+        bits *= 2; // Keep to powers of two so entries never straddle two words
+    return bits;
+}
+
+static size_t wordCountForBits(uint8_t bits) {
+    return ChunkSection::sectionVolume / (64 / bits);
+}
+
+void ChunkSection::set(int x, int y, int z, uint16_t type) {
+    if (bitsPerEntry == 0) {
+        if (type == uniformType)
+            return;
+        palette = {uniformType};
+        bitsPerEntry = 1;
+        data.assign(wordCountForBits(bitsPerEntry), 0);
+    }
+
+    uint64_t paletteIndex = static_cast<uint64_t>(findOrAddPaletteEntry(type));
+
+    int index = (y * sectionSize + z) * sectionSize + x;
+    int entriesPerWord = 64 / bitsPerEntry;
+    int shift = (index % entriesPerWord) * bitsPerEntry;
+    uint64_t mask = ((1ull << bitsPerEntry) - 1) << shift;
+    uint64_t& word = data[index / entriesPerWord];
+    word = (word & ~mask) | (paletteIndex << shift);
+}
+
+void ChunkSection::fill(uint16_t type) {
+    uniformType = type;
+    bitsPerEntry = 0;
+    std::vector<uint16_t>().swap(palette);
+    std::vector<uint64_t>().swap(data);
+}
+
+void ChunkSection::clear(uint16_t type) {
+    uniformType = type;
+    bitsPerEntry = 0;
+    palette.clear();
+    data.clear();
+}
+
+void ChunkSection::copyFrom(const ChunkSection& other) {
+    uniformType = other.uniformType;
+    bitsPerEntry = other.bitsPerEntry;
+    if (palette.capacity() < other.palette.size())
+        palette.reserve(std::max(other.palette.size(), palette.capacity() * 2));
+    palette.assign(other.palette.begin(), other.palette.end());
+    if (data.capacity() < other.data.size())
+        data.reserve(wordCountForBits(16));
+    data.assign(other.data.begin(), other.data.end());
+}
+
+int ChunkSection::findOrAddPaletteEntry(uint16_t type) {
+    for (size_t i = 0; i < palette.size(); i++) {
+        if (palette[i] == type)
+            return static_cast<int>(i);
+    }
+
+    if (palette.size() >= (1ull << bitsPerEntry))
+        repack(bitsPerEntry * 2);
+
+    palette.push_back(type);
+    return static_cast<int>(palette.size() - 1);
+}
+
+void ChunkSection::repack(uint8_t newBits) {
+    int oldPerWord = 64 / bitsPerEntry;
+    int newPerWord = 64 / newBits;
+    uint64_t oldMask = (1ull << bitsPerEntry) - 1;
+    uint64_t newMask = (1ull << newBits) - 1;
+
+    // Widened in place, back to front: entry i only ever moves up, onto words whose old entries are
+    // already moved. A section kept by clear() then regrows without allocating
+    data.resize(wordCountForBits(newBits), 0);
+    for (int i = sectionVolume - 1; i >= 0; i--) {
+        uint64_t value = (data[i / oldPerWord] >> ((i % oldPerWord) * bitsPerEntry)) & oldMask;
+        int shift = (i % newPerWord) * newBits;
+        uint64_t& word = data[i / newPerWord];
+        word = (word & ~(newMask << shift)) | (value << shift);
+    }
+
+    bitsPerEntry = newBits;
+}
+
+void ChunkSection::compact() {
+    if (bitsPerEntry == 0)
+        return;
+
+    int perWord = 64 / bitsPerEntry;
+    uint64_t mask = (1ull << bitsPerEntry) - 1;
+
+    std::vector<uint16_t> indices(sectionVolume);
+    std::vector<int> remap(palette.size(), -1);
+    std::vector<uint16_t> newPalette;
+
+    for (int i = 0; i < sectionVolume; i++) {
+        uint16_t value = static_cast<uint16_t>((data[i / perWord] >> ((i % perWord) * bitsPerEntry)) & mask);
+        if (remap[value] < 0) {
+            remap[value] = static_cast<int>(newPalette.size());
+            newPalette.push_back(palette[value]);
+        }
+        indices[i] = static_cast<uint16_t>(remap[value]);
+    }
+
+    if (newPalette.size() == 1) {
+        fill(newPalette[0]);
+        return;
+    }
+
+    uint8_t newBits = bitsForPaletteSize(newPalette.size());
+    std::vector<uint64_t> newData(wordCountForBits(newBits), 0);
+    int newPerWord = 64 / newBits;
+    for (int i = 0; i < sectionVolume; i++) {
+        newData[i / newPerWord] |= static_cast<uint64_t>(indices[i]) << ((i % newPerWord) * newBits);
+    }
+
+    palette = std::move(newPalette);
+    palette.shrink_to_fit();
+    data = std::move(newData);
+    bitsPerEntry = newBits;
+}
+
+static bool layerHasBlocks(const ChunkSection& section, int y) {
+    for (int z = 0; z < ChunkSection::sectionSize; z++) {
+        for (int x = 0; x < ChunkSection::sectionSize; x++) {
+            if (section.get(x, y, z) != 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+int ChunkSection::getLowestOccupiedLayer() const {
+    if (bitsPerEntry == 0)
+        return uniformType != 0 ? 0 : -1;
+    for (int y = 0; y < sectionSize; y++) {
+        if (layerHasBlocks(*this, y))
+            return y;
+    }
+    return -1;
+}
+
+int ChunkSection::getHighestOccupiedLayer() const {
+    if (bitsPerEntry == 0)
+        return uniformType != 0 ? sectionSize - 1 : -1;
+    for (int y = sectionSize - 1; y >= 0; y--) {
+        if (layerHasBlocks(*this, y))
+            return y;
+    }
+    return -1;
+}
+
+size_t ChunkSection::getMemoryUsage() const {
+    return sizeof(ChunkSection) + palette.capacity() * sizeof(uint16_t) + data.capacity() * sizeof(uint64_t);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 16x16x16 block volume stored as a palette + bit-packed palette indices.
+// A uniform section (all air, all stone...) keeps only its single block ID and
+// allocates nothing on the heap.
+class ChunkSection {
+public:
+    static const int sectionSize = 16;
+    static const int sectionVolume = sectionSize * sectionSize * sectionSize;
+
+    ChunkSection() = default;
+
+    uint16_t get(int x, int y, int z) const {
+        if (bitsPerEntry == 0)
+            return uniformType;
+        int index = (y * sectionSize + z) * sectionSize + x;
+        int entriesPerWord = 64 / bitsPerEntry;
+        uint64_t word = data[index / entriesPerWord];
+        int shift = (index % entriesPerWord) * bitsPerEntry;
+        uint64_t mask = (1ull << bitsPerEntry) - 1;
+        return palette[(word >> shift) & mask];
+    }
+
+    void set(int x, int y, int z, uint16_t type);
+    void fill(uint16_t type);
+    // Same as fill() but keeps the palette and data buffers, for pooled chunks about to be regenerated
+    void clear(uint16_t type);
+
+    // Copy that keeps this section's buffers. Packed data is grown straight to the largest size a
+    // section can need, so a reused snapshot stops allocating after its first few copies
+    void copyFrom(const ChunkSection& other);
+
+    // Drops unused palette entries and collapses the section back to uniform storage if possible
+    void compact();
+
+    bool isUniform() const { return bitsPerEntry == 0; }
+    uint16_t getUniformType() const { return uniformType; }
+    const std::vector<uint16_t>& getPalette() const { return palette; }
+    uint8_t getBitsPerEntry() const { return bitsPerEntry; }
+    const std::vector<uint64_t>& getPackedData() const { return data; }
+
+    // Lowest/highest Y layer holding a non-air block, -1 when the section is empty
+    int getLowestOccupiedLayer() const;
+    int getHighestOccupiedLayer() const;
+    size_t getMemoryUsage() const;
+
+private:
+    uint16_t uniformType = 0;
+    uint8_t bitsPerEntry = 0; // 0 = uniform, otherwise 1, 2, 4, 8 or 16
+    std::vector<uint16_t> palette;
+    std::vector<uint64_t> data;
+
+    int findOrAddPaletteEntry(uint16_t type);
+    void repack(uint8_t newBits);
+};
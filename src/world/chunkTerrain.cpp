@@ -161,12 +161,12 @@ void generateChunkTerrain(Chunk& chunk) {
 
             for (int y = 0; y < chunkHeight; y++) {
                 if (y == 0) {
-                    chunk.blocks[x][y][z].type = 6; // Bedrock
+                    chunk.setBlock(x, y, z, 6); // Bedrock
                 } else if (y > height) {
                     // Above terrain: water or air
                     int waterLevel = finalBiome ? finalBiome->waterLevel : 37;
                     int waterBlock = finalBiome ? finalBiome->waterBlock : 9;
-                    chunk.blocks[x][y][z].type = (y < waterLevel) ? static_cast<uint8_t>(waterBlock) : 0;
+                    chunk.setBlock(x, y, z, (y < waterLevel) ? static_cast<uint16_t>(waterBlock) : 0);
                     continue;
                 } else if (finalBiome && !finalBiome->layers.empty()) {
                     // Layer placement
@@ -185,11 +185,11 @@ void generateChunkTerrain(Chunk& chunk) {
                                     conditionMet = false;
 
                                 if (conditionMet) {
-                                    chunk.blocks[x][y][z].type = static_cast<uint8_t>(layer.block);
+                                    chunk.setBlock(x, y, z, static_cast<uint16_t>(layer.block));
                                 } else if (layer.fallbackBlock >= 0) {
-                                    chunk.blocks[x][y][z].type = static_cast<uint8_t>(layer.fallbackBlock);
+                                    chunk.setBlock(x, y, z, static_cast<uint16_t>(layer.fallbackBlock));
                                 } else {
-                                    chunk.blocks[x][y][z].type = static_cast<uint8_t>(layer.block);
+                                    chunk.setBlock(x, y, z, static_cast<uint16_t>(layer.block));
                                 }
                                 placed = true;
                                 layerStartDepth = 1;
@@ -197,14 +197,14 @@ void generateChunkTerrain(Chunk& chunk) {
                             }
                         } else if (layer.position == "below_top") {
                             if (depthFromTop >= layerStartDepth && depthFromTop < layerStartDepth + layer.depth) {
-                                chunk.blocks[x][y][z].type = static_cast<uint8_t>(layer.block);
+                                chunk.setBlock(x, y, z, static_cast<uint16_t>(layer.block));
                                 placed = true;
                                 break;
                             }
                             layerStartDepth += layer.depth;
                         } else if (layer.position == "fill") {
                             if (depthFromTop >= layerStartDepth) {
-                                chunk.blocks[x][y][z].type = static_cast<uint8_t>(layer.block);
+                                chunk.setBlock(x, y, z, static_cast<uint16_t>(layer.block));
                                 placed = true;
                                 break;
                             }
@@ -212,10 +212,10 @@ void generateChunkTerrain(Chunk& chunk) {
                     }
 
                     if (!placed) {
-                        chunk.blocks[x][y][z].type = 3; // Stone fallback
+                        chunk.setBlock(x, y, z, 3); // Stone fallback
                     }
                 } else {
-                    chunk.blocks[x][y][z].type = 3; // Stone fallback
+                    chunk.setBlock(x, y, z, 3); // Stone fallback
                 }
             }
         }
@@ -308,9 +308,9 @@ void generateChunkBiomeFeatures(Chunk& chunk, float threshold, int xOffset, int
             float n = seededHash(worldX, worldZ, seedOffset);
             if (n > threshold) {
                 int y = Chunk::chunkHeight - 2;
-                while (y > 0 && chunk.blocks[x][y][z].type == 0) y--;
+                while (y > 0 && chunk.getBlock(x, y, z) == 0) y--;
 
-                if (chunk.blocks[x][y][z].type == allowedBlockID)
+                if (chunk.getBlock(x, y, z) == allowedBlockID)
                     chunk.placeStructure(rotated, x - xOffset, (y + 1) + yOffset, z - zOffset);
             }
         }
@@ -326,12 +326,12 @@ void generateChunkBiomeBlocks(Chunk& chunk, float threshold, int blockID, int al
             float n = seededHash(worldX, worldZ, seedOffset);
             if (n > threshold) {
                 int y = Chunk::chunkHeight - 2;
-                while (y > 0 && chunk.blocks[x][y][z].type == 0) y--;
+                while (y > 0 && chunk.getBlock(x, y, z) == 0) y--;
 
-                if (chunk.blocks[x][y][z].type == allowedBlockID) {
+                if (chunk.getBlock(x, y, z) == allowedBlockID) {
                     int ty = (y + 1) + yOffset;
                     if (ty >= 0 && ty < Chunk::chunkHeight) 
-                        chunk.blocks[x][ty][z].type = static_cast<uint8_t>(blockID);
+                        chunk.setBlock(x, ty, z, static_cast<uint16_t>(blockID));
                 }
             }
         }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+// 8 byte vertex used by every chunk mesh, decoded in vertex.glsl, cross_vertex.glsl and liquid_vertex.glsl.
+//   low:  x (10 bits) | z (10) | face (3) | liquid top (1) | tiled (1) | occlusion (2)
+//   high: y (14 bits) | atlas tile (8) | u (5) | v (5)
+// Positions are chunk local in 1/32 block steps, offset by one block so rotated planes poking out
+// of the chunk still fit. UVs are in 1/16 of a tile, or whole tiles for tiled (greedy) quads.
+// Occlusion is the baked ambient occlusion level of the vertex, 0 (open) to 3 (fully occluded corner).
+struct ChunkVertex {
+    uint32_t low;
+    uint32_t high;
+};
+
+static_assert(sizeof(ChunkVertex) == 8, "ChunkVertex must stay 8 bytes");
+
+namespace ChunkVertexFormat {
+    constexpr float positionScale = 32.0f;
+    constexpr float positionOffset = 1.0f;
+    constexpr int atlasTiles = 16; // Tiles per atlas row
+
+    inline uint32_t packPosition(float value, uint32_t maxValue) {
+        float scaled = std::round((value + positionOffset) * positionScale);
+        return static_cast<uint32_t>(std::clamp(scaled, 0.0f, static_cast<float>(maxValue)));
+    }
+
+    inline uint32_t packUV(float value, bool tiled) {
+        float scaled = std::round(tiled ? value : value * atlasTiles);
+        return static_cast<uint32_t>(std::clamp(scaled, 0.0f, 31.0f));
+    }
+}
+
+// atlasTile is the tile's column/row in the atlas, uv the model UV (0-1 across the tile, or tiles when tiled)
+inline ChunkVertex packChunkVertex(const glm::vec3& position, const glm::vec2& atlasTile, const glm::vec2& uv,
+                                   int face, bool liquidTop = false, bool tiled = false, int occlusion = 0) {
+    using namespace ChunkVertexFormat;
+    uint32_t tile = static_cast<uint32_t>(atlasTile.x) + static_cast<uint32_t>(atlasTile.y) * atlasTiles;
+
+    ChunkVertex vertex;
+    vertex.low = packPosition(position.x, 1023) |
+                 (packPosition(position.z, 1023) << 10) |
+                 (static_cast<uint32_t>(face & 7) << 20) |
+                 (liquidTop ? 1u << 23 : 0u) |
+                 (tiled ? 1u << 24 : 0u) |
+                 (static_cast<uint32_t>(occlusion & 3) << 25);
+    vertex.high = packPosition(position.y, 16383) |
+                  ((tile & 255u) << 14) |
+                  (packUV(uv.x, tiled) << 22) |
+                  (packUV(uv.y, tiled) << 27);
+    return vertex;
+}
+
+inline glm::vec3 unpackChunkVertexPosition(const ChunkVertex& vertex) {
+    using namespace ChunkVertexFormat;
+    return glm::vec3(
+        static_cast<float>(vertex.low & 1023u),
+        static_cast<float>(vertex.high & 16383u),
+        static_cast<float>((vertex.low >> 10) & 1023u)
+    ) / positionScale - positionOffset;
+}
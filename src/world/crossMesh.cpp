@@ -0,0 +1,129 @@
+#include <algorithm>
+#include "crossMesh.hpp"
+#include "blockQuadDB.hpp"
+#include "chunkMesher.hpp"
+
+// Largest cross meshes any chunk has committed, per section and joined, see reserveFromHint(). GL thread only
+static std::vector<size_t> sectionInstanceHints;
+static size_t joinedInstanceHint = 0;
+
+GLuint CrossMesh::getTemplateTexture() {
+    static GLuint templateTexture = 0;
+    static GLuint templateBuffer = 0;
+    if (templateTexture != 0)
+        return templateTexture;
+
+    // Lookup table first, then the plane vertices of every cross block back to back
+    size_t typeCount = BlockQuadDB::size();
+    std::vector<uint32_t> texels(typeCount * 2, 0);
+    for (size_t type = 0; type < typeCount; type++) {
+        const BlockQuads& quads = BlockQuadDB::get(static_cast<uint16_t>(type));
+        if (quads.type != BlockMeshType::Cross || quads.planeVertices.empty())
+            continue;
+
+        texels[type * 2] = static_cast<uint32_t>(texels.size() / 2);
+        texels[type * 2 + 1] = static_cast<uint32_t>(quads.planeVertices.size() / 4);
+        for (const ChunkVertex& vertex : quads.planeVertices) {
+            texels.push_back(vertex.low);
+            texels.push_back(vertex.high);
+        }
+    }
+
+    glGenBuffers(1, &templateBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, templateBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, texels.size() * sizeof(uint32_t), texels.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &templateTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, templateTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, templateBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    return templateTexture;
+}
+
+GLsizei CrossMesh::getVerticesPerInstance() {
+    static GLsizei verticesPerInstance = -1;
+    if (verticesPerInstance >= 0)
+        return verticesPerInstance;
+
+    size_t maxQuads = 0;
+    for (size_t type = 0; type < BlockQuadDB::size(); type++) {
+        const BlockQuads& quads = BlockQuadDB::get(static_cast<uint16_t>(type));
+        if (quads.type == BlockMeshType::Cross)
+            maxQuads = std::max(maxQuads, quads.planeVertices.size() / 4);
+    }
+    verticesPerInstance = static_cast<GLsizei>(maxQuads * 6);
+    return verticesPerInstance;
+}
+
+CrossMesh::CrossMesh(int sectionCount, MeshArena& arena) : arena(arena), sections(sectionCount), sectionEnds(sectionCount, 0) {}
+
+CrossMesh::~CrossMesh() {
+    arena.release(allocation);
+}
+
+void CrossMesh::stageSection(int section, const std::vector<uint32_t>& sectionInstances) {
+    if (sections[section].empty() && sectionInstances.empty())
+        return;
+    if (sectionInstanceHints.size() < sections.size())
+        sectionInstanceHints.resize(sections.size(), 0);
+    assignFromHint(sections[section], sectionInstances, sectionInstanceHints[section]);
+    changed = true;
+}
+
+void CrossMesh::commit(int chunkX, int chunkZ) {
+    if (!changed)
+        return;
+    changed = false;
+
+    instances.clear();
+    size_t total = 0;
+    for (const auto& section : sections) {
+        total += section.size();
+    }
+    joinedInstanceHint = std::max(joinedInstanceHint, total);
+    reserveFromHint(instances, joinedInstanceHint);
+    for (size_t i = 0; i < sections.size(); i++) {
+        instances.insert(instances.end(), sections[i].begin(), sections[i].end());
+        sectionEnds[i] = static_cast<GLsizei>(instances.size());
+    }
+    instanceCount = instances.size();
+
+    GLsizei count = static_cast<GLsizei>(instances.size());
+    if (count > allocation.capacity) {
+        arena.release(allocation);
+        allocation = arena.allocate(count, chunkX, chunkZ);
+    }
+    arena.write(allocation.first, instances.data(), count);
+}
+
+void CrossMesh::clear() {
+    for (auto& section : sections) {
+        section.clear();
+    }
+    instances.clear();
+    std::fill(sectionEnds.begin(), sectionEnds.end(), 0);
+    instanceCount = 0;
+    changed = false;
+    arena.release(allocation);
+}
+
+void CrossMesh::appendDraws(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, uint16_t visibleSections) const {
+    if (instanceCount == 0)
+        return;
+
+    GLsizei verticesPerInstance = getVerticesPerInstance();
+    int sectionCount = static_cast<int>(sections.size());
+    for (int section = 0; section < sectionCount; section++) {
+        if (!(visibleSections & (1u << section)))
+            continue;
+        GLsizei first = section > 0 ? sectionEnds[section - 1] : 0;
+        while (section + 1 < sectionCount && (visibleSections & (1u << (section + 1))))
+            section++;
+        GLsizei count = sectionEnds[section] - first;
+        if (count == 0)
+            continue;
+        firsts.push_back((allocation.first + first) * verticesPerInstance);
+        counts.push_back(count * verticesPerInstance);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include "meshArena.hpp"
+
+// One 4 byte instance per cross block (flowers, grass, crops, lily pads), decoded in cross_vertex.glsl:
+//   x (4 bits) | z (4) | y (8) | block ID (16)
+// The quads come from the block's plane templates, every instance of a block type looks the same.
+inline uint32_t packCrossInstance(int x, int y, int z, uint16_t type) {
+    return static_cast<uint32_t>(x & 15) | (static_cast<uint32_t>(z & 15) << 4) |
+           (static_cast<uint32_t>(y & 255) << 8) | (static_cast<uint32_t>(type) << 16);
+}
+
+// Cross block instances of one chunk. Sections keep their instances on the CPU, a commit joins them
+// into the chunk's MeshArena allocation, small enough to upload whole. The pass draws without vertex
+// attributes: cross_vertex.glsl reads instance gl_VertexID / getVerticesPerInstance() from the arena
+// texture and expands it from the block's plane templates
+class CrossMesh {
+public:
+    CrossMesh(int sectionCount, MeshArena& arena);
+    ~CrossMesh();
+
+    CrossMesh(const CrossMesh&) = delete;
+    CrossMesh& operator=(const CrossMesh&) = delete;
+
+    // Replaces a section's instances, applied by the next commit()
+    void stageSection(int section, const std::vector<uint32_t>& instances);
+    // Uploads the joined instances if a section changed, a new allocation is tagged with the chunk position.
+    // GL thread only
+    void commit(int chunkX, int chunkZ);
+    // Stops drawing every section and hands the allocation back to the arena
+    void clear();
+
+    // Adds the vertex ranges of the sections set in `visibleSections` to the pass wide glMultiDrawArrays
+    // lists, one draw per run of neighbouring visible sections
+    void appendDraws(std::vector<GLint>& firsts, std::vector<GLsizei>& counts, uint16_t visibleSections) const;
+
+    size_t getInstanceCount() const { return instanceCount; }
+
+    // RG32UI texture buffer read by cross_vertex.glsl. Texel `id` holds the first texel and quad count
+    // of block `id`'s plane templates, the packed template vertices follow the table. GL thread only
+    static GLuint getTemplateTexture();
+    // Quads of the largest template times 6, instances with fewer quads collapse the rest
+    static GLsizei getVerticesPerInstance();
+
+private:
+    MeshArena& arena;
+    MeshArena::Allocation allocation;
+    std::vector<std::vector<uint32_t>> sections;
+    std::vector<uint32_t> instances; // Every section joined, what the allocation holds
+    std::vector<GLsizei> sectionEnds; // Where each section's instances end in `instances`
+    size_t instanceCount = 0;
+    bool changed = false;
+};
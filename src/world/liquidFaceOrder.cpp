@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include "liquidFaceOrder.hpp"
+#include "chunkMesher.hpp"
+
+void LiquidFaceOrder::setFaces(const std::vector<ChunkVertex>& vertices, const std::vector<unsigned int>& indices,
+                               const size_t* sectionIndexEnds, int sectionCount) {
+    // Largest face count any chunk has had, see reserveFromHint(). Only called on the GL thread
+    static size_t faceHint = 0;
+
+    clear();
+    size_t faceCount = indices.size() / 6;
+    faceHint = std::max(faceHint, faceCount);
+    reserveFromHint(faceCentroids, faceHint);
+    reserveFromHint(faceSections, faceHint);
+    reserveFromHint(faceIndices, faceHint * 6);
+    faceIndices.assign(indices.begin(), indices.begin() + faceCount * 6);
+    sectionFaceEnds.resize(sectionCount);
+    for (int i = 0; i < sectionCount; i++) {
+        sectionFaceEnds[i] = std::min(sectionIndexEnds[i] / 6, faceCount);
+    }
+
+    int section = 0;
+    for (size_t face = 0; face < faceCount; face++) {
+        size_t first = face * 6;
+        while (section < sectionCount - 1 && first >= sectionIndexEnds[section])
+            section++;
+
+        // Corners are indices 0, 1, 2 and 4 of the 0, 1, 2, 2, 3, 0 quad pattern
+        glm::vec3 centroid = (unpackChunkVertexPosition(vertices[indices[first + 0]]) +
+                              unpackChunkVertexPosition(vertices[indices[first + 1]]) +
+                              unpackChunkVertexPosition(vertices[indices[first + 2]]) +
+                              unpackChunkVertexPosition(vertices[indices[first + 4]])) / 4.0f;
+        faceCentroids.push_back(centroid);
+        faceSections.push_back(static_cast<uint8_t>(section));
+        liquidSections |= static_cast<uint16_t>(1u << section);
+        boundsMin = face == 0 ? centroid : glm::min(boundsMin, centroid);
+        boundsMax = face == 0 ? centroid : glm::max(boundsMax, centroid);
+    }
+}
+
+void LiquidFaceOrder::clear() {
+    faceCentroids.clear();
+    faceSections.clear();
+    faceIndices.clear();
+    liquidSections = 0;
+    sectionFaceEnds.clear();
+    sorted = false;
+    order.clear();
+    sortedIndices.clear();
+}
+
+bool LiquidFaceOrder::appendIndices(const glm::vec3& cameraPos, uint16_t visibleSections, std::vector<unsigned int>& out) {
+    if (faceCentroids.empty() || (visibleSections & liquidSections) == 0)
+        return false;
+
+    SortKey key;
+    glm::vec3 nearest = glm::clamp(cameraPos, boundsMin, boundsMax);
+    key.far = glm::length(cameraPos - nearest) > farDistance;
+    if (key.far) {
+        // Each axis is either below, inside or above the bounds
+        key.cell = glm::ivec3(glm::sign(nearest - cameraPos));
+    } else {
+        key.cell = glm::ivec3(glm::floor(cameraPos));
+    }
+
+    bool resorted = !sorted || !(key == sortKey);
+    if (resorted)
+        sort(key, cameraPos);
+
+    if ((visibleSections & liquidSections) == liquidSections) {
+        out.insert(out.end(), sortedIndices.begin(), sortedIndices.end());
+        return resorted;
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        if (visibleSections & (1u << faceSections[order[i]])) {
+            const unsigned int* face = &sortedIndices[i * 6];
+            out.insert(out.end(), face, face + 6);
+        }
+    }
+    return resorted;
+}
+
+void LiquidFaceOrder::appendUnsortedIndices(uint16_t visibleSections, std::vector<unsigned int>& out) const {
+    if ((visibleSections & liquidSections) == liquidSections) {
+        out.insert(out.end(), faceIndices.begin(), faceIndices.end());
+        return;
+    }
+    for (size_t section = 0; section < sectionFaceEnds.size(); section++) {
+        if (!(visibleSections & (1u << section)))
+            continue;
+        size_t firstFace = section > 0 ? sectionFaceEnds[section - 1] : 0;
+        out.insert(out.end(), faceIndices.begin() + firstFace * 6, faceIndices.begin() + sectionFaceEnds[section] * 6);
+    }
+}
+
+void LiquidFaceOrder::sort(const SortKey& key, const glm::vec3& cameraPos) {
+    // Only ever sorted on the GL thread
+    static std::vector<float> distances;
+    static std::vector<uint16_t> keys, keysScratch;
+    static std::vector<uint32_t> orderScratch;
+
+    size_t faceCount = faceCentroids.size();
+    distances.resize(faceCount);
+    if (key.far) {
+        // Far away the view rays are nearly parallel, so depth along the octant direction is close enough
+        glm::vec3 direction = glm::vec3(key.cell);
+        for (size_t face = 0; face < faceCount; face++) {
+            distances[face] = glm::dot(faceCentroids[face], direction);
+        }
+    } else {
+        for (size_t face = 0; face < faceCount; face++) {
+            distances[face] = glm::length(faceCentroids[face] - cameraPos);
+        }
+    }
+
+    float minDistance = *std::min_element(distances.begin(), distances.end());
+    float maxDistance = *std::max_element(distances.begin(), distances.end());
+    float scale = maxDistance > minDistance ? 65535.0f / (maxDistance - minDistance) : 0.0f;
+
+    // Inverted so ascending keys come out farthest first
+    keys.resize(faceCount);
+    keysScratch.resize(faceCount);
+    order.resize(faceCount);
+    orderScratch.resize(faceCount);
+    for (size_t face = 0; face < faceCount; face++) {
+        keys[face] = static_cast<uint16_t>(65535.0f - (distances[face] - minDistance) * scale);
+        order[face] = static_cast<uint32_t>(face);
+    }
+
+    for (int shift = 0; shift < 16; shift += 8) {
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < faceCount; i++) {
+            offsets[(keys[i] >> shift) & 255]++;
+        }
+        size_t total = 0;
+        for (size_t& offset : offsets) {
+            size_t count = offset;
+            offset = total;
+            total += count;
+        }
+        for (size_t i = 0; i < faceCount; i++) {
+            size_t slot = offsets[(keys[i] >> shift) & 255]++;
+            keysScratch[slot] = keys[i];
+            orderScratch[slot] = order[i];
+        }
+        keys.swap(keysScratch);
+        order.swap(orderScratch);
+    }
+
+    sortedIndices.resize(faceCount * 6);
+    for (size_t i = 0; i < faceCount; i++) {
+        std::copy_n(&faceIndices[static_cast<size_t>(order[i]) * 6], 6, &sortedIndices[i * 6]);
+    }
+    sortKey = key;
+    sorted = true;
+}
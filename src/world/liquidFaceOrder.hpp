@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "chunkVertex.hpp"
+
+// Back to front order of one chunk's liquid faces (6 indices each). Face centroids are taken once
+// when the mesh changes, the order is re-sorted only when the camera enters another block cell.
+// From far outside the liquid's bounds the faces are ordered along the direction octant towards
+// them instead, which only changes when the camera crosses one of the box's axis planes.
+// Sorting is a two pass radix sort on 16-bit quantised distances.
+class LiquidFaceOrder {
+public:
+    // Camera distance from the liquid's bounds past which the direction order is used
+    static constexpr float farDistance = 48.0f;
+
+    // Takes the centroids and indices of the joined liquid mesh, `sectionIndexEnds` is where each
+    // section's indices end
+    void setFaces(const std::vector<ChunkVertex>& vertices, const std::vector<unsigned int>& indices,
+                  const size_t* sectionIndexEnds, int sectionCount);
+    void clear();
+
+    // Appends the indices of the faces in `visibleSections` back to front for a camera at `cameraPos`
+    // (chunk local). Returns true when this call had to re-sort
+    bool appendIndices(const glm::vec3& cameraPos, uint16_t visibleSections, std::vector<unsigned int>& out);
+    // Appends the indices of the faces in `visibleSections` in mesh order, for order-independent blending
+    void appendUnsortedIndices(uint16_t visibleSections, std::vector<unsigned int>& out) const;
+
+    bool empty() const { return faceCentroids.empty(); }
+
+private:
+    struct SortKey {
+        bool far = false;
+        glm::ivec3 cell = glm::ivec3(0); // Camera block cell, or the direction octant when far
+        bool operator==(const SortKey& other) const { return far == other.far && cell == other.cell; }
+    };
+
+    std::vector<glm::vec3> faceCentroids;
+    std::vector<uint8_t> faceSections;
+    std::vector<unsigned int> faceIndices;   // 6 per face, in mesh order
+    uint16_t liquidSections = 0;            // Sections with at least one face
+    std::vector<size_t> sectionFaceEnds;     // Where each section's faces end, faces are in section order
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+
+    bool sorted = false;
+    SortKey sortKey;
+    std::vector<uint32_t> order;             // Face IDs back to front
+    std::vector<unsigned int> sortedIndices; // faceIndices in `order`, appended whole when every section is visible
+
+    void sort(const SortKey& key, const glm::vec3& cameraPos);
+};
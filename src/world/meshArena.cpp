@@ -0,0 +1,181 @@
+#include <algorithm>
+#include "meshArena.hpp"
+
+// Pages the buffer starts with, 64k elements
+static const uint32_t initialPages = 256;
+
+MeshArena::MeshArena(GLsizeiptr elementSize, GLenum dataFormat) :
+    elementSize(elementSize), dataFormat(dataFormat) {}
+
+MeshArena::~MeshArena() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteTextures(1, &pageTexture);
+    glDeleteTextures(1, &dataTexture);
+    glDeleteBuffers(1, &pageBuffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+MeshArena::Allocation MeshArena::allocate(GLsizei elements, int chunkX, int chunkZ) {
+    Allocation allocation;
+    if (elements <= 0)
+        return allocation;
+
+    uint32_t pages = static_cast<uint32_t>((elements + pageSize - 1) >> pageShift);
+    auto range = std::find_if(freeRanges.begin(), freeRanges.end(), [pages](const auto& entry) {
+        return entry.second >= pages;
+    });
+    if (range == freeRanges.end()) {
+        grow(pages);
+        // Growing leaves one free range at the end that is big enough
+        range = std::prev(freeRanges.end());
+    }
+
+    uint32_t firstPage = range->first;
+    uint32_t freePages = range->second;
+    freeRanges.erase(range);
+    if (freePages > pages)
+        freeRanges[firstPage + pages] = freePages - pages;
+
+    for (uint32_t page = firstPage; page < firstPage + pages; page++) {
+        pageChunks[page * 2] = chunkX;
+        pageChunks[page * 2 + 1] = chunkZ;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, pageBuffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, firstPage * 2 * sizeof(int32_t), pages * 2 * sizeof(int32_t), &pageChunks[firstPage * 2]);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    allocationCount++;
+    usedPages += pages;
+    allocation.first = static_cast<GLint>(firstPage << pageShift);
+    allocation.capacity = static_cast<GLsizei>(pages << pageShift);
+    return allocation;
+}
+
+void MeshArena::release(Allocation& allocation) {
+    if (allocation.capacity == 0)
+        return;
+
+    uint32_t firstPage = static_cast<uint32_t>(allocation.first) >> pageShift;
+    uint32_t pages = static_cast<uint32_t>(allocation.capacity) >> pageShift;
+    allocation = Allocation();
+    allocationCount--;
+    usedPages -= pages;
+
+    // Merge with the free ranges right after and right before
+    auto next = freeRanges.lower_bound(firstPage);
+    if (next != freeRanges.end() && next->first == firstPage + pages) {
+        pages += next->second;
+        next = freeRanges.erase(next);
+    }
+    if (next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == firstPage) {
+            previous->second += pages;
+            return;
+        }
+    }
+    freeRanges[firstPage] = pages;
+}
+
+void MeshArena::write(GLint first, const void* data, GLsizei elements) {
+    if (elements <= 0)
+        return;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, first * elementSize, elements * elementSize, data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void MeshArena::copy(GLint from, GLint to, GLsizei elements) {
+    if (elements <= 0)
+        return;
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, from * elementSize, to * elementSize, elements * elementSize);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void MeshArena::grow(uint32_t minimumPages) {
+    uint32_t newPageCount = std::max(pageCount * 2, initialPages);
+    while (newPageCount < pageCount + minimumPages)
+        newPageCount *= 2;
+
+    // Offsets stay where they are, the old contents are copied to the front of the new buffer
+    GLuint newBuffer;
+    glGenBuffers(1, &newBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(newPageCount) * pageSize * elementSize, nullptr, GL_DYNAMIC_DRAW);
+    if (buffer != 0) {
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(pageCount) * pageSize * elementSize);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    glDeleteBuffers(1, &buffer);
+    buffer = newBuffer;
+
+    pageChunks.resize(static_cast<size_t>(newPageCount) * 2, 0);
+    if (pageBuffer == 0) {
+        glGenBuffers(1, &pageBuffer);
+        glGenTextures(1, &pageTexture);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, pageBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, pageChunks.size() * sizeof(int32_t), pageChunks.data(), GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_BUFFER, pageTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32I, pageBuffer);
+
+    if (dataFormat != GL_NONE) {
+        if (dataTexture == 0)
+            glGenTextures(1, &dataTexture);
+        glBindTexture(GL_TEXTURE_BUFFER, dataTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, dataFormat, buffer);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    // The new pages join a free range that ends the old buffer
+    uint32_t firstNewPage = pageCount;
+    uint32_t newPages = newPageCount - pageCount;
+    if (!freeRanges.empty()) {
+        auto last = std::prev(freeRanges.end());
+        if (last->first + last->second == firstNewPage) {
+            last->second += newPages;
+            firstNewPage = 0;
+            newPages = 0;
+        }
+    }
+    if (newPages > 0)
+        freeRanges[firstNewPage] = newPages;
+
+    pageCount = newPageCount;
+    vertexArrayStale = true;
+    growths++;
+}
+
+void MeshArena::bindVertexArray(AttributeSetup setupAttributes, GLuint elementBuffer) {
+    if (VAO == 0)
+        glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    if (!vertexArrayStale && elementBuffer == vertexArrayElementBuffer)
+        return;
+
+    // Attribute pointers capture the buffer they were set with
+    if (setupAttributes && buffer != 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        setupAttributes();
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
+    vertexArrayStale = false;
+    vertexArrayElementBuffer = elementBuffer;
+}
+
+MeshArena::Stats MeshArena::getStats() const {
+    Stats stats;
+    stats.allocations = allocationCount;
+    stats.usedPages = usedPages;
+    stats.totalPages = pageCount;
+    stats.growths = growths;
+    stats.bytesPerPage = static_cast<size_t>(pageSize * elementSize);
+    return stats;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <glad/glad.h>
+
+// One GL buffer shared by every chunk of a render pass, handed out in pages of pageSize elements.
+// Free pages are kept as merged ranges and the buffer doubles when no range fits.
+// Each page records the chunk that owns it in a texture buffer, so a shader finds the chunk of
+// an element from its index (gl_VertexID >> pageShift) and a whole pass can go out in one multi-draw.
+// GL thread only
+class MeshArena {
+public:
+    using AttributeSetup = void (*)(); // Called with the VAO and buffer bound
+
+    static const int pageShift = 8;
+    static const GLsizei pageSize = 1 << pageShift;
+
+    // Element range of one owner, whole pages
+    struct Allocation {
+        GLint first = 0;
+        GLsizei capacity = 0;
+    };
+
+    struct Stats {
+        size_t allocations = 0;
+        size_t usedPages = 0;
+        size_t totalPages = 0;
+        size_t growths = 0;
+        size_t bytesPerPage = 0;
+    };
+
+    // dataFormat is the texture buffer format for reading elements in a shader, GL_NONE for no texture
+    MeshArena(GLsizeiptr elementSize, GLenum dataFormat = GL_NONE);
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    // At least `elements` elements for chunk (chunkX, chunkZ), grows the buffer when nothing fits
+    Allocation allocate(GLsizei elements, int chunkX, int chunkZ);
+    // Returns the pages to the free list and empties the allocation
+    void release(Allocation& allocation);
+
+    void write(GLint first, const void* data, GLsizei elements);
+    // Element ranges inside the buffer, they must not overlap
+    void copy(GLint from, GLint to, GLsizei elements);
+
+    // Binds the pass VAO, the attributes are set up again after the buffer was replaced
+    void bindVertexArray(AttributeSetup setupAttributes, GLuint elementBuffer);
+
+    // RG32I texture buffer holding chunk x/z per page
+    GLuint getPageTexture() const { return pageTexture; }
+    // The elements as a texture buffer in dataFormat, 0 without one
+    GLuint getDataTexture() const { return dataTexture; }
+
+    Stats getStats() const;
+
+private:
+    GLsizeiptr elementSize;
+    GLenum dataFormat;
+    GLuint buffer = 0;
+    GLuint pageBuffer = 0, pageTexture = 0;
+    GLuint dataTexture = 0;
+    GLuint VAO = 0;
+    bool vertexArrayStale = true;
+    GLuint vertexArrayElementBuffer = 0;
+
+    uint32_t pageCount = 0;
+    std::vector<int32_t> pageChunks; // Chunk x/z per page, mirrors the page texture
+    std::map<uint32_t, uint32_t> freeRanges; // First page -> page count, never touching each other
+    size_t allocationCount = 0;
+    size_t usedPages = 0;
+    size_t growths = 0;
+
+    void grow(uint32_t minimumPages);
+};
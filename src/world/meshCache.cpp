@@ -0,0 +1,123 @@
+#include <cstring>
+#include "meshCache.hpp"
+#include "chunkMesher.hpp"
+
+static void mix(uint64_t& hash, uint64_t value) {
+    hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 32;
+}
+
+MeshCache::MeshCache(size_t capacityBytes) : capacityBytes(capacityBytes) {
+    stats.capacityBytes = capacityBytes;
+}
+
+bool MeshCache::isCacheable(const ChunkMeshSnapshot& snapshot) {
+    return snapshot.firstSection == 0 && snapshot.lastSection == Chunk::sectionCount - 1;
+}
+
+uint64_t MeshCache::hashSnapshot(const ChunkMeshSnapshot& snapshot) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const auto& section : snapshot.sections) {
+        mix(hash, section.getUniformType());
+        mix(hash, section.getBitsPerEntry());
+        mix(hash, section.getPalette().size());
+        for (uint16_t type : section.getPalette()) {
+            mix(hash, type);
+        }
+        for (uint64_t word : section.getPackedData()) {
+            mix(hash, word);
+        }
+    }
+
+    // Borders are whole rows of 16-bit IDs, mixed four at a time
+    const uint16_t* border = &snapshot.borders[0][0][0];
+    const size_t borderCount = sizeof(snapshot.borders) / sizeof(uint16_t);
+    for (size_t i = 0; i < borderCount; i += 4) {
+        uint64_t word;
+        std::memcpy(&word, border + i, sizeof(word));
+        mix(hash, word);
+    }
+
+    for (int i = 0; i < Chunk::sectionCount; i++) {
+        uint64_t flags = (snapshot.summaries[i].empty ? 1u : 0u) | (snapshot.summaries[i].opaque ? 2u : 0u);
+        for (int n = 0; n < 4; n++) {
+            if (snapshot.neighborOpaque[n][i])
+                flags |= 4u << n;
+        }
+        mix(hash, flags);
+    }
+    mix(hash, static_cast<uint64_t>(static_cast<uint32_t>(snapshot.minBlockY)));
+    mix(hash, static_cast<uint64_t>(static_cast<uint32_t>(snapshot.maxBlockY)));
+    mix(hash, static_cast<uint64_t>(snapshot.mesher));
+    mix(hash, snapshot.ambientOcclusion ? 1u : 0u);
+    return hash;
+}
+
+bool MeshCache::find(const ChunkMeshSnapshot& snapshot, uint64_t hash, ChunkMeshData& mesh) {
+    std::shared_ptr<const ChunkMeshData> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.lookups++;
+        auto it = index.find({snapshot.chunkX, snapshot.chunkZ, hash});
+        if (it == index.end())
+            return false;
+
+        entries.splice(entries.begin(), entries, it->second);
+        entry = it->second->mesh;
+        stats.hits++;
+    }
+    // Evicting the entry meanwhile only drops the cache's reference
+    const ChunkMeshData& cached = *entry;
+
+    prepareChunkMesh(snapshot, mesh);
+    mesh.fromCache = true;
+    for (int i = 0; i < Chunk::sectionCount; i++) {
+        // Copy assignment keeps the job's buffer capacity, so hits don't allocate once warmed up
+        mesh.opaque[i].vertices = cached.opaque[i].vertices;
+        mesh.crossInstances[i] = cached.crossInstances[i];
+        mesh.liquid[i].vertices = cached.liquid[i].vertices;
+        mesh.liquid[i].indices = cached.liquid[i].indices;
+        mesh.liquid[i].indexOffset = cached.liquid[i].indexOffset;
+        mesh.skipped[i] = cached.skipped[i];
+        mesh.unmergedOpaqueVertices[i] = cached.unmergedOpaqueVertices[i];
+        mesh.connectivity[i] = cached.connectivity[i];
+    }
+    return true;
+}
+
+void MeshCache::insert(const ChunkMeshSnapshot& snapshot, uint64_t hash, const ChunkMeshData& mesh) {
+    if (!isEnabled())
+        return;
+
+    size_t bytes = mesh.getByteSize() + sizeof(ChunkMeshData);
+    if (bytes > capacityBytes)
+        return;
+
+    Key key{snapshot.chunkX, snapshot.chunkZ, hash};
+    // Copied before locking, the other workers only wait for the list update
+    auto copy = std::make_shared<ChunkMeshData>(mesh);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.count(key))
+        return;
+
+    entries.push_front({key, std::move(copy), bytes});
+    index[key] = entries.begin();
+    stats.bytes += bytes;
+    stats.inserts++;
+
+    while (stats.bytes > capacityBytes) {
+        Entry& oldest = entries.back();
+        stats.bytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+        stats.evictions++;
+    }
+}
+
+MeshCache::Stats MeshCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats result = stats;
+    result.entries = entries.size();
+    return result;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+struct ChunkMeshSnapshot;
+struct ChunkMeshData;
+
+// LRU cache of whole-chunk CPU meshes, keyed by chunk position plus a hash of everything the mesher
+// reads: the chunk's blocks, the neighbour border columns and the section summaries. A chunk that
+// unloads and regenerates with the same blocks gets its old mesh back instead of being remeshed.
+// Shared by the mesh workers, every call locks.
+class MeshCache {
+public:
+    struct Stats {
+        size_t lookups = 0;
+        size_t hits = 0;
+        size_t inserts = 0;
+        size_t evictions = 0;
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t capacityBytes = 0;
+    };
+
+    explicit MeshCache(size_t capacityBytes);
+
+    // Only full chunk rebuilds are cached, edits mesh a few sections and never repeat
+    static bool isCacheable(const ChunkMeshSnapshot& snapshot);
+    static uint64_t hashSnapshot(const ChunkMeshSnapshot& snapshot);
+
+    // Copies the cached geometry into mesh and fills in the snapshot's request fields, false on a miss.
+    // The copy runs after unlocking, other workers only wait for the lookup
+    bool find(const ChunkMeshSnapshot& snapshot, uint64_t hash, ChunkMeshData& mesh);
+    void insert(const ChunkMeshSnapshot& snapshot, uint64_t hash, const ChunkMeshData& mesh);
+
+    bool isEnabled() const { return capacityBytes > 0; }
+    Stats getStats() const;
+
+private:
+    struct Key {
+        int x, z;
+        uint64_t hash;
+        bool operator==(const Key& other) const { return x == other.x && z == other.z && hash == other.hash; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return static_cast<size_t>(key.hash); }
+    };
+    struct Entry {
+        Key key;
+        std::shared_ptr<const ChunkMeshData> mesh; // Shared so find() can copy it after unlocking
+        size_t bytes;
+    };
+
+    size_t capacityBytes;
+    std::list<Entry> entries; // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    mutable std::mutex mutex;
+    Stats stats;
+};
@@ -0,0 +1,152 @@
+#include <algorithm>
+#include "sectionMeshBuffer.hpp"
+
+// Room left for a section to grow before the buffer has to be re-laid out
+static GLsizei withSlack(GLsizei count, GLsizei minimumSlack) {
+    if (count == 0)
+        return 0;
+    return count + std::max(count / 4, minimumSlack);
+}
+
+GLuint SectionMeshBuffer::getQuadIndexBuffer() {
+    static GLuint quadIndexBuffer = 0;
+    if (quadIndexBuffer != 0)
+        return quadIndexBuffer;
+
+    std::vector<GLushort> indices(static_cast<size_t>(maxQuadsPerDraw) * 6);
+    for (GLsizei quad = 0; quad < maxQuadsPerDraw; quad++) {
+        GLushort offset = static_cast<GLushort>(quad * 4);
+        GLushort* index = &indices[static_cast<size_t>(quad) * 6];
+        index[0] = offset;
+        index[1] = offset + 1;
+        index[2] = offset + 2;
+        index[3] = offset + 2;
+        index[4] = offset + 3;
+        index[5] = offset;
+    }
+
+    glGenBuffers(1, &quadIndexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, quadIndexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return quadIndexBuffer;
+}
+
+SectionMeshBuffer::SectionMeshBuffer(int sectionCount, MeshArena& arena) :
+    arena(arena), slots(sectionCount) {}
+
+SectionMeshBuffer::~SectionMeshBuffer() {
+    arena.release(allocation);
+}
+
+void SectionMeshBuffer::stageSection(int section, const std::vector<ChunkVertex>& vertices) {
+    for (auto& entry : staged) {
+        if (entry.section == section) {
+            entry.vertices = &vertices;
+            return;
+        }
+    }
+    staged.push_back({section, &vertices});
+}
+
+void SectionMeshBuffer::commit(int chunkX, int chunkZ) {
+    if (staged.empty())
+        return;
+
+    bool fits = allocation.capacity > 0;
+    for (const auto& entry : staged) {
+        if (static_cast<GLsizei>(entry.vertices->size()) > slots[entry.section].vertexCapacity) {
+            fits = false;
+            break;
+        }
+    }
+
+    if (fits) {
+        for (const auto& entry : staged) {
+            Slot& slot = slots[entry.section];
+            arena.write(allocation.first + slot.firstVertex, entry.vertices->data(), static_cast<GLsizei>(entry.vertices->size()));
+            slot.vertexCount = static_cast<GLsizei>(entry.vertices->size());
+        }
+    } else {
+        relayout(chunkX, chunkZ);
+    }
+
+    staged.clear();
+    updateDrawLists();
+}
+
+void SectionMeshBuffer::relayout(int chunkX, int chunkZ) {
+    std::vector<const StagedSection*> stagedFor(slots.size(), nullptr);
+    for (const auto& entry : staged) {
+        stagedFor[entry.section] = &entry;
+    }
+
+    std::vector<Slot> newSlots(slots.size());
+    GLsizei vertexTotal = 0;
+    for (size_t i = 0; i < slots.size(); i++) {
+        Slot& slot = newSlots[i];
+        slot.vertexCount = stagedFor[i] ? static_cast<GLsizei>(stagedFor[i]->vertices->size()) : slots[i].vertexCount;
+        // 16 quads of headroom so a few placed blocks don't force another re-layout
+        slot.vertexCapacity = withSlack(slot.vertexCount, 64);
+        slot.firstVertex = vertexTotal;
+        vertexTotal += slot.vertexCapacity;
+    }
+
+    // Page rounding leaves spare room at the end, the last section with quads gets it
+    MeshArena::Allocation newAllocation = arena.allocate(vertexTotal, chunkX, chunkZ);
+    for (size_t i = slots.size(); i-- > 0;) {
+        if (newSlots[i].vertexCapacity == 0) continue;
+        newSlots[i].vertexCapacity += newAllocation.capacity - vertexTotal;
+        break;
+    }
+
+    for (size_t i = 0; i < slots.size(); i++) {
+        if (stagedFor[i] || slots[i].vertexCount == 0) continue;
+        arena.copy(allocation.first + slots[i].firstVertex, newAllocation.first + newSlots[i].firstVertex, slots[i].vertexCount);
+    }
+    for (const auto& entry : staged) {
+        arena.write(newAllocation.first + newSlots[entry.section].firstVertex, entry.vertices->data(),
+                    static_cast<GLsizei>(entry.vertices->size()));
+    }
+
+    arena.release(allocation);
+    allocation = newAllocation;
+    slots = std::move(newSlots);
+}
+
+void SectionMeshBuffer::clear() {
+    staged.clear();
+    for (auto& slot : slots) {
+        slot = Slot();
+    }
+    arena.release(allocation);
+    updateDrawLists();
+}
+
+void SectionMeshBuffer::updateDrawLists() {
+    drawCounts.clear();
+    drawBaseVertices.clear();
+    drawSections.clear();
+    vertexCount = 0;
+    for (size_t section = 0; section < slots.size(); section++) {
+        const Slot& slot = slots[section];
+        vertexCount += slot.vertexCount;
+        // Every draw starts at the top of the quad index buffer, the base vertex walks through the section
+        GLsizei quadCount = slot.vertexCount / 4;
+        for (GLsizei firstQuad = 0; firstQuad < quadCount; firstQuad += maxQuadsPerDraw) {
+            drawCounts.push_back(std::min(quadCount - firstQuad, maxQuadsPerDraw) * 6);
+            drawBaseVertices.push_back(allocation.first + slot.firstVertex + firstQuad * 4);
+            drawSections.push_back(static_cast<uint8_t>(section));
+        }
+    }
+}
+
+void SectionMeshBuffer::appendDraws(std::vector<GLsizei>& counts, std::vector<GLint>& baseVertices,
+                                    uint16_t visibleSections) const {
+    for (size_t i = 0; i < drawCounts.size(); i++) {
+        if (visibleSections & (1u << drawSections[i])) {
+            counts.push_back(drawCounts[i]);
+            baseVertices.push_back(drawBaseVertices[i]);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include "chunkVertex.hpp"
+#include "meshArena.hpp"
+
+// The quads of every section of one chunk, in one MeshArena allocation where each section has its
+// own range with some room to grow. A rebuilt section that still fits is written over its old range,
+// only a section that outgrew its range re-lays the chunk out into a new allocation, and the untouched
+// sections are then copied over on the GPU. Vertices come in quads of 4 and share one static 16-bit
+// quad index buffer, appendDraws() adds the sections to the pass wide glMultiDrawElementsBaseVertex.
+class SectionMeshBuffer {
+public:
+    // Quads one draw can address with 16-bit indices, bigger sections are split into several draws
+    static constexpr GLsizei maxQuadsPerDraw = 65536 / 4;
+
+    SectionMeshBuffer(int sectionCount, MeshArena& arena);
+    ~SectionMeshBuffer();
+
+    SectionMeshBuffer(const SectionMeshBuffer&) = delete;
+    SectionMeshBuffer& operator=(const SectionMeshBuffer&) = delete;
+
+    // Queues new quads for a section, applied by the next commit(). The vector is read in place
+    // and has to stay alive until then
+    void stageSection(int section, const std::vector<ChunkVertex>& vertices);
+    // Uploads every staged section, a new allocation is tagged with the chunk position. GL thread only
+    void commit(int chunkX, int chunkZ);
+    // Stops drawing every section and hands the allocation back to the arena
+    void clear();
+
+    // Adds a draw per section set in `visibleSections` (or per maxQuadsPerDraw quads) to the pass lists
+    void appendDraws(std::vector<GLsizei>& counts, std::vector<GLint>& baseVertices, uint16_t visibleSections) const;
+    size_t getDrawCount() const { return drawCounts.size(); }
+
+    GLsizei getIndexCount() const { return static_cast<GLsizei>(vertexCount / 4 * 6); }
+    size_t getVertexCount() const { return vertexCount; }
+
+    // Element buffer with the 0, 1, 2, 2, 3, 0 pattern for maxQuadsPerDraw quads as GLushort,
+    // created on first use and shared by every quad mesh. GL thread only
+    static GLuint getQuadIndexBuffer();
+
+private:
+    struct Slot {
+        GLint firstVertex = 0; // Inside the allocation
+        GLsizei vertexCapacity = 0;
+        GLsizei vertexCount = 0;
+    };
+
+    struct StagedSection {
+        int section;
+        const std::vector<ChunkVertex>* vertices;
+    };
+
+    MeshArena& arena;
+    MeshArena::Allocation allocation;
+    std::vector<Slot> slots;
+    std::vector<StagedSection> staged;
+    size_t vertexCount = 0;
+
+    // Per draw, rebuilt after every commit() so appendDraws() only copies
+    std::vector<GLsizei> drawCounts;
+    std::vector<GLint> drawBaseVertices;
+    std::vector<uint8_t> drawSections;
+
+    void relayout(int chunkX, int chunkZ);
+    void updateDrawLists();
+};
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <cmath>
+#include "sectionVisibility.hpp"
+#include "world.hpp"
+
+// Neighbour section per face, same order as the connectivity bits
+static const int faceSteps[6][3] = {
+    { 0,  0,  1}, // front
+    { 0,  0, -1}, // back
+    {-1,  0,  0}, // left
+    { 1,  0,  0}, // right
+    { 0,  1,  0}, // top
+    { 0, -1,  0}  // bottom
+};
+static const int oppositeFaces[6] = {1, 0, 3, 2, 5, 4};
+
+void SectionVisibility::update(const ChunkMap& chunks, const glm::dvec3& cameraPos, const Frustum& frustum, bool culling) {
+    int previousOriginX = originX, previousOriginZ = originZ;
+    int previousWidth = width;
+    visible.swap(previousVisible);
+    findVisible(chunks, cameraPos, frustum, culling);
+    if (originX != previousOriginX || originZ != previousOriginZ || width != previousWidth || visible != previousVisible)
+        version++;
+}
+
+void SectionVisibility::findVisible(const ChunkMap& chunks, const glm::dvec3& cameraPos, const Frustum& frustum, bool culling) {
+    stats = Stats();
+    if (chunks.empty()) {
+        width = depth = 0;
+        visible.clear();
+        return;
+    }
+
+    int minX = chunks[0].x, maxX = minX;
+    int minZ = chunks[0].z, maxZ = minZ;
+    for (const auto& entry : chunks) {
+        minX = std::min(minX, entry.x);
+        maxX = std::max(maxX, entry.x);
+        minZ = std::min(minZ, entry.z);
+        maxZ = std::max(maxZ, entry.z);
+    }
+    originX = minX;
+    originZ = minZ;
+    width = maxX - minX + 1;
+    depth = maxZ - minZ + 1;
+    visible.assign(static_cast<size_t>(width) * depth, 0);
+
+    for (const auto& entry : chunks) {
+        if (World::isChunkInFrustum(entry.x, entry.z, frustum, cameraPos))
+            stats.frustumSections += Chunk::sectionCount;
+    }
+
+    int cameraX = static_cast<int>(std::floor(cameraPos.x / Chunk::chunkWidth));
+    int cameraZ = static_cast<int>(std::floor(cameraPos.z / Chunk::chunkDepth));
+    int cameraSection = static_cast<int>(std::floor(cameraPos.y / ChunkSection::sectionSize));
+    Chunk* cameraChunk = chunks.find(cameraX, cameraZ);
+    if (!culling || !cameraChunk || cameraSection < 0 || cameraSection >= Chunk::sectionCount) {
+        for (const auto& entry : chunks) {
+            if (World::isChunkInFrustum(entry.x, entry.z, frustum, cameraPos))
+                visibleAt(entry.x, entry.z) = static_cast<uint16_t>((1u << Chunk::sectionCount) - 1);
+        }
+        stats.visibleSections = stats.frustumSections;
+        return;
+    }
+    stats.culling = true;
+
+    queue.clear();
+    queue.push_back({cameraChunk, cameraX, cameraZ, static_cast<int8_t>(cameraSection), -1, 0});
+    visibleAt(cameraX, cameraZ) |= static_cast<uint16_t>(1u << cameraSection);
+    for (size_t head = 0; head < queue.size(); head++) {
+        Node node = queue[head];
+        uint64_t connectivity = node.chunk->getSectionConnectivity(node.section);
+
+        for (int face = 0; face < 6; face++) {
+            if (node.entryFace >= 0 && !(connectivity & getFaceConnectionBit(node.entryFace, face)))
+                continue;
+            // Turning back toward the camera can't show anything the walk has not reached already
+            if (node.directions & (1u << oppositeFaces[face]))
+                continue;
+
+            int section = node.section + faceSteps[face][1];
+            if (section < 0 || section >= Chunk::sectionCount)
+                continue;
+            int chunkX = node.chunkX + faceSteps[face][0];
+            int chunkZ = node.chunkZ + faceSteps[face][2];
+            Chunk* chunk = node.chunk;
+            if (chunkX != node.chunkX || chunkZ != node.chunkZ) {
+                chunk = chunks.find(chunkX, chunkZ);
+                if (!chunk)
+                    continue;
+            }
+
+            uint16_t& sections = visibleAt(chunkX, chunkZ);
+            uint16_t bit = static_cast<uint16_t>(1u << section);
+            if ((sections & bit) || !World::isSectionInFrustum(chunkX, section, chunkZ, frustum, cameraPos))
+                continue;
+            sections |= bit;
+            queue.push_back({chunk, chunkX, chunkZ, static_cast<int8_t>(section), static_cast<int8_t>(oppositeFaces[face]),
+                             static_cast<uint8_t>(node.directions | (1u << face))});
+        }
+    }
+    stats.visibleSections = queue.size();
+}
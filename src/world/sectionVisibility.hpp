@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Chunk;
+class ChunkMap;
+struct Frustum;
+
+// Which faces of a 16x16x16 section reach each other through non-opaque blocks, bit from * 6 + to.
+// Faces follow the mesher: front (z+1), back (z-1), left (x-1), right (x+1), top (y+1), bottom (y-1)
+inline uint64_t getFaceConnectionBit(int from, int to) {
+    return 1ull << (from * 6 + to);
+}
+static const uint64_t allFacesConnected = (1ull << 36) - 1;
+
+// Cave culling: sections the camera can see into, found without GPU queries.
+// update() walks breadth first from the camera's section, leaving each section only through faces
+// connected to the one it was entered by, never heading back toward the camera and never leaving
+// the frustum. Sections behind solid ground or outside the caves the camera is in are not reached
+class SectionVisibility {
+public:
+    struct Stats {
+        size_t visibleSections = 0;
+        size_t frustumSections = 0; // Sections of the chunks in the frustum, what would be drawn without culling
+        bool culling = false;       // False when every section of the frustum chunks was marked visible
+    };
+
+    // With `culling` off, or the camera above or below the chunks, marks every section of the frustum chunks
+    void update(const ChunkMap& chunks, const glm::dvec3& cameraPos, const Frustum& frustum, bool culling);
+    // Bit per visible section of the chunk as of the last update()
+    uint16_t getVisibleSections(int chunkX, int chunkZ) const {
+        int x = chunkX - originX;
+        int z = chunkZ - originZ;
+        if (x < 0 || z < 0 || x >= width || z >= depth)
+            return 0;
+        return visible[static_cast<size_t>(z) * width + x];
+    }
+    const Stats& getStats() const { return stats; }
+    // Bumped by every update() whose visible sections differ from the previous one
+    uint64_t getVersion() const { return version; }
+
+private:
+    struct Node {
+        Chunk* chunk;
+        int chunkX, chunkZ;
+        int8_t section;
+        int8_t entryFace;   // Face the walk came in through, -1 for the camera's section
+        uint8_t directions; // Bit per face direction taken on the way here
+    };
+
+    int originX = 0, originZ = 0;
+    int width = 0, depth = 0;
+    std::vector<uint16_t> visible; // Section bits per chunk of the loaded area
+    std::vector<uint16_t> previousVisible; // Last update()'s bits, to tell whether anything changed
+    uint64_t version = 0;
+    std::vector<Node> queue;       // Kept so its capacity carries over between frames
+    Stats stats;
+
+    void findVisible(const ChunkMap& chunks, const glm::dvec3& cameraPos, const Frustum& frustum, bool culling);
+    uint16_t& visibleAt(int chunkX, int chunkZ) {
+        return visible[static_cast<size_t>(chunkZ - originZ) * width + (chunkX - originX)];
+    }
+};
@@ -1,4 +1,5 @@
 #include <fstream>
+#include <mutex>
 #include <nlohmannJSON/json.hpp>
 #include "structureDB.hpp"
 
@@ -8,8 +9,11 @@
 // 3xxx = 1 in 20
 
 std::unordered_map<std::string, Structure> StructureDB::structures;
+static std::mutex structuresMutex;
 
+// Called from terrain generation workers, structures are loaded on first use
 const Structure* StructureDB::get(const std::string& name) {
+    std::lock_guard<std::mutex> lock(structuresMutex);
     auto iterator = structures.find(name);
     if (iterator != structures.end())
         return &iterator->second;
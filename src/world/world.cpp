@@ -1,37 +1,295 @@
 #include <glm/gtc/matrix_access.hpp>
 #include <iostream>
 #include <cmath>
-#include <deque>
 #include <algorithm>
+#include <chrono>
 #include "world.hpp"
+#include "chunkMesher.hpp"
 #include "../core/options.hpp"
+#include "../core/allocationCounter.hpp"
 
-static std::deque<std::pair<int, int>> chunkLoadQueue;
+// Finished mesh jobs kept for reuse, each holds a snapshot and mesh buffers sized by earlier rebuilds
+static const size_t maxIdleMeshJobs = 32;
 
-World::World() {}
+// All chunk meshes share the packed ChunkVertex layout, read as two integers by the shaders
+static void setupChunkVertexAttributes() {
+    glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(ChunkVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+}
+
+World::World() :
+    opaqueArena(sizeof(ChunkVertex)),
+    crossArena(sizeof(uint32_t), GL_R32UI),
+    liquidArena(sizeof(ChunkVertex)),
+    chunkPool(this, static_cast<size_t>(std::max(0, getOptionInt("chunk_pool_size", 256)))),
+    noises(noiseInit()),
+    workerPool(std::make_unique<WorkerPool>(getOptionInt("worldgen_threads", 3))),
+    meshCache(static_cast<size_t>(std::max(0, getOptionInt("mesh_cache_mb", 64))) * 1024 * 1024) {
+
+    loadQueue.setPriorityFunction([this](int x, int z) { return getLoadPriority(x, z); });
+    idleMeshJobs.reserve(maxIdleMeshJobs);
+    AllocationCounter::setEnabled(getOptionInt("count_allocations", 0) != 0);
+}
 
 World::~World() {
-    for (auto& [coord, chunk] : chunks) {
-        delete chunk;
+    // Stop the workers first, queued jobs still point at their chunks
+    workerPool.reset();
+    for (const auto& job : generationJobs) {
+        delete job->chunk;
+    }
+    generationJobs.clear();
+
+    for (const auto& entry : chunks) {
+        delete entry.chunk;
     }
     chunks.clear();
+
+    glDeleteBuffers(1, &liquidIndexBuffer);
+}
+
+int World::getChunkPriority(int x, int z) const {
+    if (lastPlayerChunkX == INT32_MIN)
+        return 0;
+    int offsetX = x - lastPlayerChunkX;
+    int offsetZ = z - lastPlayerChunkZ;
+    return offsetX * offsetX + offsetZ * offsetZ;
+}
+
+// Distance in chunks, stretched up to 2x for chunks behind the camera
+float World::getLoadPriority(int x, int z) const {
+    if (lastPlayerChunkX == INT32_MIN)
+        return 0.0f;
+    float offsetX = static_cast<float>(x - lastPlayerChunkX);
+    float offsetZ = static_cast<float>(z - lastPlayerChunkZ);
+    float distance = std::sqrt(offsetX * offsetX + offsetZ * offsetZ);
+    if (distance < 1.0f)
+        return distance;
+
+    float facing = (offsetX * viewDirection.x + offsetZ * viewDirection.y) / distance; // 1 ahead, -1 behind
+    return distance * (1.0f + (1.0f - facing) * 0.5f);
+}
+
+void World::setViewDirection(const glm::vec3& front) {
+    glm::vec2 direction(front.x, front.z);
+    float length = glm::length(direction);
+    direction = length > 0.001f ? direction / length : glm::vec2(0.0f);
+
+    // Re-rank only after a noticeable turn, about 15 degrees
+    if (glm::dot(direction, viewDirection) < 0.966f) {
+        viewDirection = direction;
+        loadQueue.invalidatePriorities();
+    }
+}
+
+void World::queueChunkGeneration(int x, int z, int priority) {
+    auto job = std::make_shared<GenerationJob>();
+    job->x = x;
+    job->z = z;
+    job->chunk = chunkPool.acquire(x, z);
+    generationJobs.push_back(job);
+    generatingChunks.insert({x, z});
+
+    workerPool->submit(priority, [job]() {
+        job->chunk->generateTerrain();
+        job->finished.store(true, std::memory_order_release);
+    });
+}
+
+void World::adoptChunk(const GenerationJob& job) {
+    chunks.insert(job.x, job.z, job.chunk);
+    job.chunk->finishGeneration();
 }
 
 void World::generateChunks(int radius) {
-    // Create chunks
+    chunks.setWindowSize(radius * 2 + 1);
+
+    // Create chunks, generated in parallel and adopted in the order they were queued
     for (int x = -radius; x <= radius; x++) {
         for (int z = -radius; z <= radius; z++) {
-            std::pair<int, int> pos = {x, z};
-            if (chunks.find(pos) == chunks.end()) {
-                chunks[pos] = new Chunk(x, z, this);
+            if (!chunks.find(x, z) && !generatingChunks.count({x, z})) {
+                queueChunkGeneration(x, z, 0);
+            }
+        }
+    }
+    workerPool->waitIdle();
+    while (!generationJobs.empty()) {
+        std::shared_ptr<GenerationJob> job = generationJobs.front();
+        generationJobs.pop_front();
+        generatingChunks.erase({job->x, job->z});
+        adoptChunk(*job);
+    }
+
+    // Build meshes, startup waits for them instead of streaming them in
+    for (const auto& entry : chunks) {
+        entry.chunk->buildMesh();
+    }
+    rebuildDirtyMeshes(true);
+    workerPool->waitIdle();
+    uploadMeshes(true);
+}
+
+void World::requestMeshRebuild(Chunk* chunk, uint16_t sections) {
+    meshStats.rebuildsRequested++;
+    bool listed = chunk->isMeshDirty();
+    chunk->addDirtyMeshSections(sections);
+    if (!listed)
+        dirtyChunks.push_back({chunk->chunkX, chunk->chunkZ});
+}
+
+void World::rebuildDirtyMeshes(bool ignoreBudget) {
+    if (!dirtyChunks.empty()) {
+        static int rebuildsPerFrame = std::max(1, getOptionInt("chunk_rebuilds_per_frame", 8));
+
+        std::sort(dirtyChunks.begin(), dirtyChunks.end(),
+            [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                return getChunkPriority(a.first, a.second) < getChunkPriority(b.first, b.second);
+            }
+        );
+
+        int performed = 0;
+        size_t processed = 0;
+        for (; processed < dirtyChunks.size(); processed++) {
+            if (!ignoreBudget && performed >= rebuildsPerFrame)
+                break;
+
+            // Unloaded or recycled since it was marked
+            Chunk* chunk = getChunk(dirtyChunks[processed].first, dirtyChunks[processed].second);
+            if (!chunk || !chunk->isMeshDirty())
+                continue;
+
+            if (queueMeshBuild(chunk, chunk->takeDirtyMeshSections())) {
+                meshStats.rebuildsPerformed++;
+                performed++;
+            }
+        }
+        dirtyChunks.erase(dirtyChunks.begin(), dirtyChunks.begin() + processed);
+    }
+    meshStats.dirtyChunks = dirtyChunks.size();
+}
+
+bool World::queueMeshBuild(Chunk* chunk, uint16_t sections) {
+    // One contiguous range per snapshot, edits rarely leave gaps worth splitting around
+    int firstSection = 0;
+    while (!(sections & (1u << firstSection)))
+        firstSection++;
+    int lastSection = Chunk::sectionCount - 1;
+    while (!(sections & (1u << lastSection)))
+        lastSection--;
+
+    AllocationCounter::Scope countAllocations;
+    ChunkMeshJob* job;
+    if (!idleMeshJobs.empty()) {
+        job = idleMeshJobs.back();
+        idleMeshJobs.pop_back();
+    } else {
+        meshJobs.push_back(std::make_unique<ChunkMeshJob>());
+        job = meshJobs.back().get();
+        pendingUploads.reserve(meshJobs.size());
+        std::lock_guard<std::mutex> lock(finishedMeshesMutex);
+        finishedMeshes.reserve(meshJobs.size());
+        meshStats.meshJobsCreated++;
+    }
+
+    if (!chunk->createMeshSnapshot(job->snapshot, firstSection, lastSection)) {
+        idleMeshJobs.push_back(job);
+        return false;
+    }
+
+    meshStats.sectionsRebuilt += lastSection - firstSection + 1;
+    meshStats.inFlight++;
+    auto task = [this, job]() {
+        using clock = std::chrono::steady_clock;
+        AllocationCounter::Scope countAllocations;
+        // A chunk that comes back with the same blocks and neighbours reuses its old mesh
+        bool cacheable = meshCache.isEnabled() && MeshCache::isCacheable(job->snapshot);
+        uint64_t hash = cacheable ? MeshCache::hashSnapshot(job->snapshot) : 0;
+        auto start = clock::now();
+        bool hit = cacheable && meshCache.find(job->snapshot, hash, job->mesh);
+        if (!hit) {
+            // Only the mesher is timed on a miss, so the build average stays comparable between mesher= modes
+            start = clock::now();
+            buildChunkMesh(job->snapshot, job->mesh);
+        }
+        job->mesh.buildMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        if (!hit && cacheable)
+            meshCache.insert(job->snapshot, hash, job->mesh);
+
+        std::lock_guard<std::mutex> lock(finishedMeshesMutex);
+        finishedMeshes.push_back(job);
+    };
+    // libstdc++ and MSVC keep two pointers inside std::function, anything bigger is heap allocated per rebuild
+    static_assert(sizeof(task) <= 2 * sizeof(void*), "Mesh task must fit std::function's inline storage");
+    workerPool->submit(getChunkPriority(chunk->chunkX, chunk->chunkZ), task);
+    return true;
+}
+
+void World::uploadMeshes(bool ignoreBudget) {
+    AllocationCounter::Scope countAllocations;
+    {
+        std::lock_guard<std::mutex> lock(finishedMeshesMutex);
+        for (ChunkMeshJob* job : finishedMeshes) {
+            if (job->mesh.fromCache) {
+                meshStats.meshCacheHits++;
+                meshStats.meshCacheHitMs += job->mesh.buildMs;
+            } else {
+                meshStats.meshesBuilt++;
+                meshStats.meshBuildMs += job->mesh.buildMs;
             }
+            pendingUploads.push_back(job);
         }
+        meshStats.inFlight -= static_cast<int>(finishedMeshes.size());
+        finishedMeshes.clear();
     }
 
-    // Build meshes
-    for (auto& [coord, chunk] : chunks) {
-        chunk->buildMesh();
+    static size_t budgetBytes = static_cast<size_t>(std::max(1, getOptionInt("mesh_upload_kb_per_frame", 2048))) * 1024;
+    static double budgetMs = static_cast<double>(std::max(1, getOptionInt("mesh_upload_ms_per_frame", 4)));
+
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    size_t uploadedBytes = 0;
+    bool uploadedAny = false;
+
+    size_t uploadCount = 0;
+    for (; uploadCount < pendingUploads.size(); uploadCount++) {
+        // Always upload at least one mesh per frame so a huge chunk can't stall the queue
+        if (!ignoreBudget && uploadedAny) {
+            double elapsedMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+            if (uploadedBytes >= budgetBytes || elapsedMs >= budgetMs)
+                break;
+        }
+
+        ChunkMeshJob* job = pendingUploads[uploadCount];
+        const ChunkMeshData& mesh = job->mesh;
+
+        int sectionCount = mesh.lastSection - mesh.firstSection + 1;
+        Chunk* chunk = getChunk(mesh.chunkX, mesh.chunkZ);
+        if (!chunk) {
+            meshStats.droppedStale += sectionCount;
+        } else {
+            // Sections covered by a newer snapshot or edited since are dropped one by one
+            uploadedBytes += mesh.getByteSize();
+            int dropped = chunk->uploadMesh(mesh);
+            meshStats.droppedStale += dropped;
+            if (dropped < sectionCount)
+                meshStats.uploaded++;
+            uploadedAny = true;
+        }
+
+        // A startup burst leaves far more jobs than steady state needs, only keep a few around
+        if (idleMeshJobs.size() < maxIdleMeshJobs) {
+            idleMeshJobs.push_back(job);
+        } else {
+            auto owner = std::find_if(meshJobs.begin(), meshJobs.end(),
+                                      [job](const std::unique_ptr<ChunkMeshJob>& ownedJob) { return ownedJob.get() == job; });
+            std::swap(*owner, meshJobs.back());
+            meshJobs.pop_back();
+        }
     }
+    pendingUploads.erase(pendingUploads.begin(), pendingUploads.begin() + uploadCount);
+    meshStats.idleMeshJobs = idleMeshJobs.size();
+
+    meshStats.awaitingUpload = pendingUploads.size();
+    meshStats.uploadedBytesLastFrame = uploadedBytes;
 }
 
 void World::updateChunksAroundPlayer(const glm::dvec3& playerPos, int radius, bool force) {
@@ -43,56 +301,67 @@ void World::updateChunksAroundPlayer(const glm::dvec3& playerPos, int radius, bo
         lastPlayerChunkX = playerChunkX;
         lastPlayerChunkZ = playerChunkZ;
 
-        // Unload chunks outside radius
-        for (auto iterator = chunks.begin(); iterator != chunks.end();) {
-            int chunkOffsetX = iterator->first.first - playerChunkX;
-            int chunkOffsetZ = iterator->first.second - playerChunkZ;
+        // Unload chunks outside radius, walk backwards since erase swaps the last chunk in
+        for (size_t i = chunks.size(); i-- > 0;) {
+            const ChunkMap::Entry& entry = chunks[i];
+            int chunkOffsetX = entry.x - playerChunkX;
+            int chunkOffsetZ = entry.z - playerChunkZ;
             if (std::abs(chunkOffsetX) > radius || std::abs(chunkOffsetZ) > radius) {
-                delete iterator->second;
-                iterator = chunks.erase(iterator);
-            } else {
-                iterator++;
+                chunkPool.release(chunks.erase(entry.x, entry.z));
             }
         }
+        chunks.setWindowSize(radius * 2 + 1);
 
-        chunkLoadQueue.clear();
-        std::vector<std::pair<int, int>> positions;
+        // Drop queued positions that fell out of range, re-rank the rest lazily against the new center
+        loadQueue.cancelOutside(playerChunkX, playerChunkZ, radius);
+        loadQueue.invalidatePriorities();
         for (int x = -radius; x <= radius; x++) {
             for (int z = -radius; z <= radius; z++) {
                 int chunkX = playerChunkX + x;
                 int chunkZ = playerChunkZ + z;
-                std::pair<int, int> pos = {chunkX, chunkZ};
-                if (chunks.find(pos) == chunks.end()) {
-                    positions.push_back(pos);
+                if (!chunks.find(chunkX, chunkZ) && !generatingChunks.count({chunkX, chunkZ}) && !loadQueue.contains(chunkX, chunkZ)) {
+                    loadQueue.push(chunkX, chunkZ);
                 }
             }
         }
-        std::sort(positions.begin(), positions.end(),
-            [playerChunkX, playerChunkZ](const std::pair<int, int>& a, const std::pair<int, int>& b) {
-                int distanceA = (a.first - playerChunkX) * (a.first - playerChunkX) + (a.second - playerChunkZ) * (a.second - playerChunkZ);
-                int distanceB = (b.first - playerChunkX) * (b.first - playerChunkX) + (b.second - playerChunkZ) * (b.second - playerChunkZ);
-                return distanceA < distanceB;
-            }
-        );
-        for (const auto& pos : positions) {
-            chunkLoadQueue.push_back(pos);
-        }
     }
 
+    // Keep a couple of jobs per worker in flight, the rest stays in the queue where it can still be cancelled or re-ranked
+    size_t maxGenerating = static_cast<size_t>(workerPool->getThreadCount()) * 2;
+    ChunkLoadQueue::Entry entry;
+    while (generationJobs.size() < maxGenerating && loadQueue.pop(entry)) {
+        queueChunkGeneration(entry.x, entry.z, getChunkPriority(entry.x, entry.z));
+    }
+
+    // Adopt in submission order so structures crossing chunk borders end up the same no matter which worker finished first
     static int chunksToLoadPerFrame = getOptionInt("chunks_to_load_per_frame", 1);
-    for (int i = 0; i < chunksToLoadPerFrame && !chunkLoadQueue.empty(); i++) {
-        auto pos = chunkLoadQueue.front();
-        chunkLoadQueue.pop_front();
-        Chunk* newChunk = new Chunk(pos.first, pos.second, this);
-        chunks[pos] = newChunk;
-        newChunk->buildMesh();
+    int adopted = 0;
+    while (adopted < chunksToLoadPerFrame && !generationJobs.empty() &&
+           generationJobs.front()->finished.load(std::memory_order_acquire)) {
+        std::shared_ptr<GenerationJob> job = generationJobs.front();
+        generationJobs.pop_front();
+        generatingChunks.erase({job->x, job->z});
+
+        // Player moved away while it was generating
+        if (std::abs(job->x - lastPlayerChunkX) > radius || std::abs(job->z - lastPlayerChunkZ) > radius) {
+            chunkPool.release(job->chunk);
+            loadQueue.recordCancelled();
+            continue;
+        }
+
+        adoptChunk(*job);
+        job->chunk->buildMesh();
         static const int neighborChunkOffsetX[4] = {-1, 1, 0, 0};
         static const int neighborChunkOffsetZ[4] = {0, 0, -1, 1};
         for (int i = 0; i < 4; i++) {
-            auto neighbor = getChunk(pos.first + neighborChunkOffsetX[i], pos.second + neighborChunkOffsetZ[i]);
+            auto neighbor = getChunk(job->x + neighborChunkOffsetX[i], job->z + neighborChunkOffsetZ[i]);
             if (neighbor) neighbor->buildMesh();  
         }
+        loadQueue.recordCompleted();
+        adopted++;
     }
+
+    rebuildDirtyMeshes();
 }
 
 Frustum World::extractFrustumPlanes(const glm::mat4& projView) {
@@ -106,75 +375,197 @@ Frustum World::extractFrustumPlanes(const glm::mat4& projView) {
     return frustum;
 }
 
-bool World::isChunkInFrustum(int chunkX, int chunkZ, const Frustum& frustum, const glm::dvec3& cameraPos) {
-    double minX = static_cast<double>(chunkX * Chunk::chunkWidth) - cameraPos.x;
-    double maxX = minX + static_cast<double>(Chunk::chunkWidth);
-    double minY = 0.0 - cameraPos.y;
-    double maxY = static_cast<double>(Chunk::chunkHeight) - cameraPos.y;
-    double minZ = static_cast<double>(chunkZ * Chunk::chunkDepth) - cameraPos.z;
-    double maxZ = minZ + static_cast<double>(Chunk::chunkDepth);
-
+// Box relative to the camera, outside when all eight corners are behind one plane
+static bool isBoxInFrustum(const glm::dvec3& min, const glm::dvec3& max, const Frustum& frustum) {
     for (int i = 0; i < 6; i++) {
         const glm::vec4& plane = frustum.planes[i];
         int out = 0;
-        out += (glm::dot(plane, glm::vec4(minX, minY, minZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(maxX, minY, minZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(minX, maxY, minZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(maxX, maxY, minZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(minX, minY, maxZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(maxX, minY, maxZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(minX, maxY, maxZ, 1.0f)) < 0.0f) ? 1 : 0;
-        out += (glm::dot(plane, glm::vec4(maxX, maxY, maxZ, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(min.x, min.y, min.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(max.x, min.y, min.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(min.x, max.y, min.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(max.x, max.y, min.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(min.x, min.y, max.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(max.x, min.y, max.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(min.x, max.y, max.z, 1.0f)) < 0.0f) ? 1 : 0;
+        out += (glm::dot(plane, glm::vec4(max.x, max.y, max.z, 1.0f)) < 0.0f) ? 1 : 0;
         if (out == 8) return false;
     }
     return true;
 }
 
-void World::render(const Camera& camera, GLint uModelLoc, const Frustum& frustum) {
-    glm::dvec3 camPos = camera.getPositionDouble();
-    for (auto& [coord, chunk] : chunks) {
-        if (isChunkInFrustum(coord.first, coord.second, frustum, camPos))
-            chunk->render(camera, uModelLoc);
+bool World::isChunkInFrustum(int chunkX, int chunkZ, const Frustum& frustum, const glm::dvec3& cameraPos) {
+    glm::dvec3 min = glm::dvec3(chunkX * Chunk::chunkWidth, 0.0, chunkZ * Chunk::chunkDepth) - cameraPos;
+    glm::dvec3 max = min + glm::dvec3(Chunk::chunkWidth, Chunk::chunkHeight, Chunk::chunkDepth);
+    return isBoxInFrustum(min, max, frustum);
+}
+
+bool World::isSectionInFrustum(int chunkX, int section, int chunkZ, const Frustum& frustum, const glm::dvec3& cameraPos) {
+    glm::dvec3 min = glm::dvec3(chunkX * Chunk::chunkWidth, section * ChunkSection::sectionSize, chunkZ * Chunk::chunkDepth) - cameraPos;
+    glm::dvec3 max = min + glm::dvec3(Chunk::chunkWidth, ChunkSection::sectionSize, Chunk::chunkDepth);
+    return isBoxInFrustum(min, max, frustum);
+}
+
+void World::cullSections(const Camera& camera, const Frustum& frustum) {
+    static bool caveCulling = getOptionInt("cave_culling", 1) != 0;
+    sectionVisibility.update(chunks, camera.getPositionDouble(), frustum, caveCulling);
+}
+
+void World::render() {
+    renderStats = RenderStats();
+    drawCounts.clear();
+    drawBaseVertices.clear();
+    for (const auto& entry : chunks) {
+        uint16_t sections = sectionVisibility.getVisibleSections(entry.x, entry.z);
+        if (sections == 0)
+            continue;
+        size_t previousDraws = drawCounts.size();
+        entry.chunk->appendDraws(drawCounts, drawBaseVertices, sections);
+        if (drawCounts.size() > previousDraws)
+            renderStats.perChunkDrawCalls++;
+        renderStats.visibleChunks++;
     }
+    if (drawCounts.empty())
+        return;
+
+    // Every draw starts at the top of the shared quad index buffer, the base vertex picks the quads
+    drawOffsets.assign(drawCounts.size(), nullptr);
+    glActiveTexture(GL_TEXTURE0 + pageTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, opaqueArena.getPageTexture());
+    opaqueArena.bindVertexArray(setupChunkVertexAttributes, SectionMeshBuffer::getQuadIndexBuffer());
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, drawCounts.data(), GL_UNSIGNED_SHORT, drawOffsets.data(),
+                                  static_cast<GLsizei>(drawCounts.size()), drawBaseVertices.data());
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+
+    renderStats.drawCalls++;
+    renderStats.subDraws += drawCounts.size();
 }
 
-void World::renderCross(const Camera& camera, GLint uCrossModelLoc, const Frustum& frustum) {
-    glm::dvec3 camPos = camera.getPositionDouble();
-    for (auto& [coord, chunk] : chunks) {
-        if (isChunkInFrustum(coord.first, coord.second, frustum, camPos))
-            chunk->renderCross(camera, uCrossModelLoc);
+void World::renderCross() {
+    drawFirsts.clear();
+    drawCounts.clear();
+    size_t chunkDraws = 0;
+    for (const auto& entry : chunks) {
+        uint16_t sections = sectionVisibility.getVisibleSections(entry.x, entry.z);
+        if (sections == 0)
+            continue;
+        size_t previousDraws = drawCounts.size();
+        entry.chunk->appendCrossDraw(drawFirsts, drawCounts, sections);
+        if (drawCounts.size() > previousDraws)
+            chunkDraws++;
     }
+    renderStats.perChunkDrawCalls += chunkDraws;
+    if (drawCounts.empty())
+        return;
+
+    // No vertex attributes, cross_vertex.glsl fetches the instances from the arena texture
+    glActiveTexture(GL_TEXTURE0 + pageTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, crossArena.getPageTexture());
+    glActiveTexture(GL_TEXTURE0 + crossInstanceTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, crossArena.getDataTexture());
+    crossArena.bindVertexArray(nullptr, 0);
+    glMultiDrawArrays(GL_TRIANGLES, drawFirsts.data(), drawCounts.data(), static_cast<GLsizei>(drawCounts.size()));
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+
+    renderStats.drawCalls++;
+    renderStats.subDraws += drawCounts.size();
 }
-void World::renderLiquid(const Camera& camera, GLint uLiquidModelLoc, const Frustum& frustum) {
-    std::vector<std::pair<float, Chunk*>> visible;
-    visible.reserve(chunks.size());
 
+void World::renderLiquid(const Camera& camera, bool sortFaces) {
     glm::dvec3 camPos = camera.getPositionDouble();
-    for (auto& [coord, chunk] : chunks) {
-        if (!isChunkInFrustum(coord.first, coord.second, frustum, camPos))
-            continue;
+    glm::ivec3 cameraCell = glm::ivec3(glm::floor(camPos));
+    // LiquidFaceOrder keys its sort on the same cell, so no chunk re-sorts while it stays put
+    if ((sortFaces && cameraCell != liquidCameraCell) || sortFaces != liquidDrawsSorted ||
+        sectionVisibility.getVersion() != liquidVisibilityVersion)
+        liquidDrawsDirty = true;
+
+    bool upload = liquidDrawsDirty;
+    if (liquidDrawsDirty) {
+        liquidDrawsDirty = false;
+        liquidDrawsSorted = sortFaces;
+        liquidCameraCell = cameraCell;
+        liquidVisibilityVersion = sectionVisibility.getVersion();
 
-        float cx = (coord.first * Chunk::chunkWidth) + (Chunk::chunkWidth * 0.5f);
-        float cz = (coord.second * Chunk::chunkDepth) + (Chunk::chunkDepth * 0.5f);
-        float dx = static_cast<float>(camPos.x - cx);
-        float dy = static_cast<float>(camPos.y);
-        float dz = static_cast<float>(camPos.z - cz);
-        float dist2 = dx*dx + dy*dy + dz*dz;
-        visible.emplace_back(dist2, chunk);
+        liquidChunks.clear();
+        for (const auto& entry : chunks) {
+            if (!entry.chunk->hasLiquidDraw() || sectionVisibility.getVisibleSections(entry.x, entry.z) == 0)
+                continue;
+
+            float dist2 = 0.0f;
+            if (sortFaces) {
+                float cx = (entry.x * Chunk::chunkWidth) + (Chunk::chunkWidth * 0.5f);
+                float cz = (entry.z * Chunk::chunkDepth) + (Chunk::chunkDepth * 0.5f);
+                float dx = static_cast<float>(camPos.x - cx);
+                float dy = static_cast<float>(camPos.y);
+                float dz = static_cast<float>(camPos.z - cz);
+                dist2 = dx*dx + dy*dy + dz*dz;
+            }
+            liquidChunks.emplace_back(dist2, entry.chunk);
+        }
+
+        if (sortFaces) {
+            std::sort(liquidChunks.begin(), liquidChunks.end(), [](const auto& A, const auto& B) {
+                return A.first > B.first;
+            });
+        }
+
+        // Draws inside a multi-draw run in order, so the chunks stay back to front
+        liquidIndices.clear();
+        liquidDrawCounts.clear();
+        liquidDrawOffsets.clear();
+        liquidDrawBaseVertices.clear();
+        for (auto& p : liquidChunks) {
+            uint16_t sections = sectionVisibility.getVisibleSections(p.second->chunkX, p.second->chunkZ);
+            if (p.second->appendLiquidDraw(camera, sections, sortFaces, liquidIndices, liquidDrawCounts,
+                                           liquidDrawOffsets, liquidDrawBaseVertices))
+                renderStats.liquidSorts++;
+        }
     }
 
-    std::sort(visible.begin(), visible.end(), [](const auto& A, const auto& B) {
-        return A.first > B.first;
-    });
+    renderStats.perChunkDrawCalls += liquidDrawCounts.size();
+    if (liquidDrawCounts.empty())
+        return;
 
-    for (auto& p : visible) {
-        p.second->renderLiquid(camera, uLiquidModelLoc);
+    if (liquidIndexBuffer == 0)
+        glGenBuffers(1, &liquidIndexBuffer);
+    glActiveTexture(GL_TEXTURE0 + pageTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, liquidArena.getPageTexture());
+    liquidArena.bindVertexArray(setupChunkVertexAttributes, liquidIndexBuffer);
+    if (upload) {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, liquidIndices.size() * sizeof(GLuint), liquidIndices.data(), GL_STREAM_DRAW);
+        renderStats.liquidUploaded = true;
     }
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, liquidDrawCounts.data(), GL_UNSIGNED_INT, liquidDrawOffsets.data(),
+                                  static_cast<GLsizei>(liquidDrawCounts.size()), liquidDrawBaseVertices.data());
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+
+    renderStats.drawCalls++;
+    renderStats.subDraws += liquidDrawCounts.size();
 }
 
-Chunk* World::getChunk(int x, int z) const {
-    auto iterator = chunks.find({x, z});
-    if (iterator != chunks.end())
-        return iterator->second;
-    return nullptr;
+int World::getSkippedSectionCount() const {
+    int skipped = 0;
+    for (const auto& entry : chunks) {
+        skipped += entry.chunk->getSkippedSectionCount();
+    }
+    return skipped;
+}
+
+void World::getOpaqueVertexCounts(size_t& vertices, size_t& unmergedVertices) const {
+    vertices = 0;
+    unmergedVertices = 0;
+    for (const auto& entry : chunks) {
+        vertices += entry.chunk->getOpaqueVertexCount();
+        unmergedVertices += entry.chunk->getUnmergedOpaqueVertexCount();
+    }
+}
+
+size_t World::getCrossInstanceCount() const {
+    size_t instances = 0;
+    for (const auto& entry : chunks) {
+        instances += entry.chunk->getCrossInstanceCount();
+    }
+    return instances;
 }
@@ -1,11 +1,24 @@
 #pragma once
 
-#include <map>
 #include <vector>
+#include <deque>
+#include <set>
+#include <memory>
+#include <atomic>
+#include <mutex>
 #include <glm/glm.hpp>
 #include "chunk.hpp"
+#include "chunkMap.hpp"
+#include "chunkPool.hpp"
+#include "chunkLoadQueue.hpp"
+#include "meshArena.hpp"
+#include "meshCache.hpp"
+#include "noise.hpp"
+#include "sectionVisibility.hpp"
+#include "../core/workerPool.hpp"
 
 class Chunk;
+struct ChunkMeshJob;
 
 struct Frustum {
     glm::vec4 planes[6];
@@ -16,20 +29,150 @@ public:
     World();
     ~World();
 
-    Chunk* getChunk(int x, int z) const;
+    Chunk* getChunk(int x, int z) const { return chunks.find(x, z); }
+    size_t getChunkCount() const { return chunks.size(); }
+    const ChunkMap& getChunks() const { return chunks; }
+    int getSkippedSectionCount() const;
+    // Opaque vertices across loaded chunks, and how many one quad per face would have needed
+    void getOpaqueVertexCounts(size_t& vertices, size_t& unmergedVertices) const;
+    size_t getCrossInstanceCount() const;
+    ChunkPool::Stats getChunkPoolStats() const { return chunkPool.getStats(); }
+    const ChunkNoises& getNoises() const { return noises; }
+    int getWorldgenThreadCount() const { return workerPool->getThreadCount(); }
+    size_t getGeneratingChunkCount() const { return generationJobs.size(); }
+    ChunkLoadQueue::Stats getLoadQueueStats() const { return loadQueue.getStats(); }
+
+    struct MeshStats {
+        int inFlight = 0;             // Snapshots handed to workers, not yet picked up for upload
+        size_t awaitingUpload = 0;    // Finished meshes left over from the last upload budget
+        size_t uploaded = 0;
+        size_t droppedStale = 0;      // Sections older than their latest edit or request
+        size_t uploadedBytesLastFrame = 0;
+        size_t rebuildsRequested = 0; // Every Chunk::buildMesh() call
+        size_t rebuildsPerformed = 0; // Snapshots actually meshed after coalescing
+        size_t sectionsRebuilt = 0;   // Sections covered by those snapshots
+        size_t dirtyChunks = 0;
+        size_t meshesBuilt = 0;       // Meshes back from the workers that went through the mesher
+        double meshBuildMs = 0.0;     // Worker time spent in the mesher for them
+        size_t meshCacheHits = 0;     // Meshes back from the workers that were copied from the mesh cache
+        double meshCacheHitMs = 0.0;  // Worker time spent copying them
+        size_t meshJobsCreated = 0;   // Jobs allocated because none were idle
+        size_t idleMeshJobs = 0;
+    };
+    const MeshStats& getMeshStats() const { return meshStats; }
+    MeshCache::Stats getMeshCacheStats() const { return meshCache.getStats(); }
+
+    // Last frame's submissions, every pass is one multi-draw over its arena
+    struct RenderStats {
+        size_t drawCalls = 0;         // GL draw calls issued
+        size_t perChunkDrawCalls = 0; // What a draw per chunk and pass, with a VAO and model matrix each, would issue
+        size_t subDraws = 0;          // Draws inside the multi-draws
+        size_t visibleChunks = 0;
+        size_t liquidSorts = 0;       // Chunks whose liquid faces had to be re-sorted
+        bool liquidUploaded = false;  // The liquid index stream changed and was re-uploaded
+    };
+    const RenderStats& getRenderStats() const { return renderStats; }
+    const SectionVisibility::Stats& getSectionVisibilityStats() const { return sectionVisibility.getStats(); }
+    MeshArena& getOpaqueArena() { return opaqueArena; }
+    MeshArena& getCrossArena() { return crossArena; }
+    MeshArena& getLiquidArena() { return liquidArena; }
+    MeshArena::Stats getOpaqueArenaStats() const { return opaqueArena.getStats(); }
+    MeshArena::Stats getCrossArenaStats() const { return crossArena.getStats(); }
+    MeshArena::Stats getLiquidArenaStats() const { return liquidArena.getStats(); }
+
+    // Texture units the chunk shaders read the arena page tables and the cross instances from
+    static const int pageTextureUnit = 2;
+    static const int crossInstanceTextureUnit = 3;
 
     void generateChunks(int radius);
-    void render(const Camera& camera, GLint uModelLoc, const Frustum& frustum);
-    void renderCross(const Camera& camera, GLint uCrossModelLoc, const Frustum& frustum);
-    void renderLiquid(const Camera& camera, GLint uLiquidModelLoc, const Frustum& frustum);
+    // Number for a new mesh snapshot. One counter for every chunk, so a chunk object created at a position
+    // that had one before can never match results still in flight for the old one
+    uint64_t takeMeshRequest() { return ++lastMeshRequest; }
+    // Adds the chunk to the dirty list with a bit per section to rebuild, repeated requests before the next rebuild coalesce
+    void requestMeshRebuild(Chunk* chunk, uint16_t sections);
+    // Rebuilds dirty chunks nearest first, up to the per-frame budget
+    void rebuildDirtyMeshes(bool ignoreBudget = false);
+    // Uploads finished meshes within the per-frame budget, call once per frame on the GL thread
+    void uploadMeshes(bool ignoreBudget = false);
+    // Finds the sections the passes draw this frame, call before render()
+    void cullSections(const Camera& camera, const Frustum& frustum);
+    // Each pass is one multi-draw of the visible sections, the bound program reads the chunk of every
+    // vertex from the page texture
+    void render();
+    void renderCross();
+    // Back to front unless `sortFaces` is off, for order-independent blending. Last frame's draw lists and
+    // index buffer are drawn again unless the camera cell, the visible sections or a liquid mesh changed
+    void renderLiquid(const Camera& camera, bool sortFaces = true);
+    // A chunk's liquid mesh changed or went away, the next renderLiquid() rebuilds its draw lists
+    void invalidateLiquidDraws() { liquidDrawsDirty = true; }
 
     void updateChunksAroundPlayer(const glm::dvec3& playerPos, int radius, bool force = false);
+    // Chunks in front of the camera load first, call before updateChunksAroundPlayer()
+    void setViewDirection(const glm::vec3& front);
 
     static Frustum extractFrustumPlanes(const glm::mat4& projView);
     static bool isChunkInFrustum(int chunkX, int chunkZ, const Frustum& frustum, const glm::dvec3& cameraPos);
+    static bool isSectionInFrustum(int chunkX, int section, int chunkZ, const Frustum& frustum, const glm::dvec3& cameraPos);
 
 private:
-    std::map<std::pair<int, int>, Chunk*> chunks;
+    // Chunk handed to the worker pool, adopted into `chunks` once generated
+    struct GenerationJob {
+        int x, z;
+        Chunk* chunk;
+        std::atomic<bool> finished{false};
+    };
+
+    // Declared before the chunks, which hand their allocations back when destroyed
+    MeshArena opaqueArena;
+    MeshArena crossArena;
+    MeshArena liquidArena;
+    GLuint liquidIndexBuffer = 0; // Sorted liquid indices of the frame, re-specified when they change
+
+    ChunkMap chunks;
+    ChunkPool chunkPool;
+    ChunkNoises noises; // Built once on the main thread, workers copy it per chunk
+    std::unique_ptr<WorkerPool> workerPool;
+    std::deque<std::shared_ptr<GenerationJob>> generationJobs; // Submission order
+    std::set<std::pair<int, int>> generatingChunks;
+    ChunkLoadQueue loadQueue; // Positions waiting for a free generation slot
+    glm::vec2 viewDirection = glm::vec2(0.0f); // XZ direction the queue was last ranked with
+
+    // Mesh jobs are owned by meshJobs and passed around as plain pointers, so the worker task only
+    // captures two pointers and fits std::function's inline storage. The lists below are reserved for
+    // every job there is, adding to them never allocates
+    std::vector<std::unique_ptr<ChunkMeshJob>> meshJobs;
+    std::mutex finishedMeshesMutex;
+    std::vector<ChunkMeshJob*> finishedMeshes; // Filled by workers
+    std::vector<ChunkMeshJob*> pendingUploads; // Oldest first
+    std::vector<ChunkMeshJob*> idleMeshJobs; // Uploaded jobs kept for reuse, main thread only
+    MeshStats meshStats;
+    uint64_t lastMeshRequest = 0; // Main thread only, see takeMeshRequest()
+    MeshCache meshCache; // Full chunk meshes of chunks seen before, shared by the mesh workers
+    std::vector<std::pair<int, int>> dirtyChunks;
+    RenderStats renderStats;
+    SectionVisibility sectionVisibility; // Rebuilt by cullSections() every frame
+    // Multi-draw lists, kept so their capacity carries over between frames
+    std::vector<GLsizei> drawCounts;
+    std::vector<GLint> drawFirsts;
+    std::vector<const void*> drawOffsets;
+    std::vector<GLint> drawBaseVertices;
+    // The liquid pass keeps its own lists, drawn again as they are while nothing they depend on changed
+    std::vector<std::pair<float, Chunk*>> liquidChunks; // Visible chunks with liquid, back to front when sorted
+    std::vector<GLsizei> liquidDrawCounts;
+    std::vector<const void*> liquidDrawOffsets;
+    std::vector<GLint> liquidDrawBaseVertices;
+    std::vector<GLuint> liquidIndices; // What liquidIndexBuffer holds
+    bool liquidDrawsDirty = true;
+    bool liquidDrawsSorted = false;
+    glm::ivec3 liquidCameraCell = glm::ivec3(0); // Chunks only re-sort their faces when this changes
+    uint64_t liquidVisibilityVersion = 0;
     int lastPlayerChunkX = INT32_MIN;
     int lastPlayerChunkZ = INT32_MIN;
+
+    int getChunkPriority(int x, int z) const;
+    float getLoadPriority(int x, int z) const;
+    void queueChunkGeneration(int x, int z, int priority);
+    void adoptChunk(const GenerationJob& job);
+    // Snapshots the chunk's dirty sections and meshes them on the worker pool, false when a neighbour is missing
+    bool queueMeshBuild(Chunk* chunk, uint16_t sections);
 };